@@ -10,6 +10,7 @@
 #include "cinder/gl/gl.h"
 
 #include "PolynomialPopulation.h"
+#include "PolynomialDensityData.h"
 
 using namespace ci;
 using namespace ci::app;
@@ -37,8 +38,10 @@ public:
 	
 	PolynomialPopulation*	mPopulation;
 	PolynomialDataRef		mBest;
+	PolynomialDensityDataRef	mDensity;
 	
 	GuiPlot*				mPlotRef;
+	GuiPlot*				mFitnessPlotRef;
 };
 
 void PolynomialEvolutionApp::prepareSettings(Settings* settings)
@@ -98,10 +101,18 @@ void PolynomialEvolutionApp::setup()
 	
 	cout << tAssertGroup.getAssertionString( tFormula ) << endl;
 	
-	mPopulation = new PolynomialPopulation( tAssertGroup, 1000, 500, 0.1, 1.0 );
+	PlotSeriesRef tBestSeries(    new PlotSeries( 500, 1024, ColorA( 0, 1, 1, 1 ) ) );
+	PlotSeriesRef tAverageSeries( new PlotSeries( 500, 1024, ColorA( 1, 1, 1, 1 ) ) );
+	PlotSeriesRef tWorstSeries(   new PlotSeries( 500, 1024, ColorA( 1, 0.5, 0, 1 ) ) );
+	
+	mPopulation = new PolynomialPopulation( tAssertGroup, 1000, 500, 0.1, 1.0,
+										   PolynomialPopulation::Format().fitnessSeries( tBestSeries, tAverageSeries, tWorstSeries ).snapshotInterval( 1 ) );
 	
 	{
+		mDensity = PolynomialDensityDataRef( new PolynomialDensityData( ColorA( 0, 1, 1, 0.75 ) ) );
+		
 		mPlotRef = new GuiPlot( "Heuristica", mSuitcase );
+		mPlotRef->addInput( mDensity );
 		mPlotRef->addInput( tFormula );
 		mPlotRef->addInput( tAssertFormulaA );
 		mPlotRef->addInput( tAssertFormulaB );
@@ -110,10 +121,25 @@ void PolynomialEvolutionApp::setup()
 		mPlotRef->setFillColor( ColorA( 1, 0, 0, 1 ) );
 		mPlotRef->setStrokeColor( ColorA( 1, 1, 0, 1 ) );
 		mPlotRef->setStrokeWeight( 1.0 );
-		mPlotRef->setRelativePosition( Vec2f( 0.5, 0.5 ) );
-		mPlotRef->setRelativeDimension( Vec2f( 0.9, 0.9 ) );
+		mPlotRef->setRelativePosition( Vec2f( 0.5, 0.15 ) );
+		mPlotRef->setRelativeDimension( Vec2f( 0.9, 0.65 ) );
 		mScene->addChild( mPlotRef );
 	}
+	
+	{
+		mFitnessPlotRef = new GuiPlot( "Heuristica", mSuitcase );
+		mFitnessPlotRef->addInput( tWorstSeries );
+		mFitnessPlotRef->addInput( tAverageSeries );
+		mFitnessPlotRef->addInput( tBestSeries );
+		mFitnessPlotRef->setXRange( 0.0, 500.0 );
+		mFitnessPlotRef->setYRange( 0.0, 1.0 );
+		mFitnessPlotRef->setFillColor( ColorA( 0, 0, 0.5, 1 ) );
+		mFitnessPlotRef->setStrokeColor( ColorA( 1, 1, 0, 1 ) );
+		mFitnessPlotRef->setStrokeWeight( 1.0 );
+		mFitnessPlotRef->setRelativePosition( Vec2f( 0.5, 0.9 ) );
+		mFitnessPlotRef->setRelativeDimension( Vec2f( 0.9, 0.2 ) );
+		mScene->addChild( mFitnessPlotRef );
+	}
 }
 
 void PolynomialEvolutionApp::mouseMove(MouseEvent event)
@@ -175,6 +201,8 @@ void PolynomialEvolutionApp::update()
 		// Update info label:
 		mInfoLabel->setText( mBest->getFormulaString() );
 	}
+	// Update population overlay:
+	mDensity->setSnapshot( mPopulation->getSnapshot() );
 	// Update info label:
 	//mInfoLabel->setText( "FPS: " + to_string( getAverageFps() ) + "\t\tRunning Time: " + to_string( getElapsedSeconds() ) + " seconds" );
 }
@@ -186,7 +214,10 @@ void PolynomialEvolutionApp::draw()
 	gl::setViewport( toPixels( getWindowBounds() ) );
 	
 	if( mScene ) {
+		// Draw scene, batching text by font:
+		mSuitcase->getBatch().begin();
 		mScene->deepDraw();
+		mSuitcase->getBatch().end();
 	}
 	
 	//saveFrame( "/Users/pjh/Desktop/test_renders/" );
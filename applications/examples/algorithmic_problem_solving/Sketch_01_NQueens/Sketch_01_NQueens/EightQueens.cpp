@@ -8,11 +8,17 @@
 
 #include "EightQueens.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace std;
 
 NQueensBoard::NQueensBoard(int iTilesPerAxis)
-: mTilesPerAxis(iTilesPerAxis), mSolutionCount(0), mTotalCallCount(0), mTempCallCount(0)
+: mTilesPerAxis(iTilesPerAxis), mQueenRows(iTilesPerAxis, 0), mSink(NULL), mCountOnly(false), mSolutionCount(0), mTotalCallCount(0), mTempCallCount(0)
 {
+	// Initialize row mask:
+	mFullMask = ( mTilesPerAxis >= 32 ) ? 0xFFFFFFFF : ( ( 1u << mTilesPerAxis ) - 1 );
 	// Initialize rows:
 	mBoard = new bool*[mTilesPerAxis];
 	//Iterate over each row:
@@ -41,10 +47,101 @@ void NQueensBoard::solveWithBacktracking()
 {
 	// Start the recursive process:
 	recursiveSolve( 0 );
+	if( mSink ) { mSink->flush(); }
 	// Print the total number of calls:
 	cout << "Total calls to recursiveSolve(): " << mTotalCallCount << endl;
 }
 
+void NQueensBoard::solveWithBitmasks(const bool& iCountOnly)
+{
+	if( mTilesPerAxis > 32 ) {
+		cout << "ERROR: Bitmask search supports at most 32 tiles per axis." << endl;
+		return;
+	}
+	// Reset analytics:
+	mCountOnly      = iCountOnly;
+	mSolutionCount  = 0;
+	mTotalCallCount = 0;
+	mTempCallCount  = 0;
+	// Start the recursive process:
+	bitmaskSolve( 0, 0, 0, 0 );
+	if( mSink && !mCountOnly ) { mSink->flush(); }
+	mTotalCallCount += mTempCallCount;
+	// Print the totals:
+	cout << "Total solutions: " << mSolutionCount << endl;
+	cout << "Total calls to bitmaskSolve(): " << mTotalCallCount << endl;
+}
+
+void NQueensBoard::countInParallel(const int& iThreadCount)
+{
+	if( mTilesPerAxis > 32 ) {
+		cout << "ERROR: Bitmask search supports at most 32 tiles per axis." << endl;
+		return;
+	}
+	mSolutionCount = 0;
+	if( mTilesPerAxis < 2 ) {
+		mSolutionCount = bitmaskCount( 0, mTilesPerAxis, mFullMask, 0, 0, 0 );
+		cout << "Total solutions: " << mSolutionCount << endl;
+		return;
+	}
+	// Build one task per safe placement in the first two columns, with the first queen in the upper half:
+	struct Task {
+		uint32_t	mRows, mDiagUp, mDiagDown;
+		uint64_t	mWeight;	//!< 2 if the task's mirror image is not searched, otherwise 1
+		uint64_t	mCount;
+	};
+	vector<Task> tTasks;
+	for(int r = 0; r < ( mTilesPerAxis + 1 ) / 2; r++) {
+		uint32_t tBit      = 1u << r;
+		uint32_t tRows     = tBit;
+		uint32_t tDiagUp   = ( tBit << 1 ) & mFullMask;
+		uint32_t tDiagDown = tBit >> 1;
+		uint32_t tAvailable = mFullMask & ~( tRows | tDiagUp | tDiagDown );
+		while( tAvailable ) {
+			uint32_t tNext = tAvailable & ( ~tAvailable + 1 );
+			tAvailable ^= tNext;
+			Task tTask;
+			tTask.mRows     = tRows | tNext;
+			tTask.mDiagUp   = ( ( tDiagUp | tNext ) << 1 ) & mFullMask;
+			tTask.mDiagDown = ( tDiagDown | tNext ) >> 1;
+			tTask.mWeight   = ( mTilesPerAxis % 2 == 1 && r == mTilesPerAxis / 2 ) ? 1 : 2;
+			tTask.mCount    = 0;
+			tTasks.push_back( tTask );
+		}
+	}
+	// Run the tasks on a pool of threads:
+	int tThreadCount = ( iThreadCount > 0 ) ? iThreadCount : (int)std::max( thread::hardware_concurrency(), 1u );
+	atomic<size_t>  tNextTask( 0 );
+	vector<thread>  tThreads;
+	for(int t = 0; t < tThreadCount; t++) {
+		tThreads.push_back( thread( [&]() {
+			size_t i;
+			while( ( i = tNextTask++ ) < tTasks.size() ) {
+				Task& tTask = tTasks[ i ];
+				tTask.mCount = bitmaskCount( 2, mTilesPerAxis, mFullMask, tTask.mRows, tTask.mDiagUp, tTask.mDiagDown );
+			}
+		} ) );
+	}
+	for(size_t t = 0; t < tThreads.size(); t++) {
+		tThreads[ t ].join();
+	}
+	// Merge the task counters:
+	for(size_t i = 0; i < tTasks.size(); i++) {
+		mSolutionCount += tTasks[ i ].mWeight * tTasks[ i ].mCount;
+	}
+	cout << "Total solutions: " << mSolutionCount << " (" << tTasks.size() << " tasks on " << tThreadCount << " threads)" << endl;
+}
+
+void NQueensBoard::setSolutionSink(SolutionSink* iSink)
+{
+	mSink = iSink;
+}
+
+uint64_t NQueensBoard::getSolutionCount() const
+{
+	return mSolutionCount;
+}
+
 bool NQueensBoard::rowIsSafe(const int& iRow, const int& iCol) const
 {
 	// Iterate over each column for row (except iCol):
@@ -101,7 +198,7 @@ bool NQueensBoard::tileIsSafe(const int& iRow, const int& iCol) const
 
 void NQueensBoard::printBoard() const
 {
-	cout << "BOARD SOLUTION #" << mSolutionCount << " required " << mTempCallCount << " calls to recursiveSolve():" << endl << endl;
+	cout << "BOARD SOLUTION #" << mSolutionCount << " required " << mTempCallCount << " calls to recursiveSolve():\n\n";
 	//Iterate over each row:
 	for(int i = 0; i < mTilesPerAxis; i++) {
 		// Iterate over each column:
@@ -111,10 +208,18 @@ void NQueensBoard::printBoard() const
 			// Otherwise, print blank tile:
 			else               { cout << "\t-"; }
 		}
-		cout << endl << endl;
+		cout << "\n\n";
 	}
 }
 
+void NQueensBoard::emitSolution()
+{
+	// Stream the compact encoding to the sink, if one is set:
+	if( mSink ) { mSink->write( &mQueenRows[ 0 ], mTilesPerAxis ); }
+	// Otherwise, print board:
+	else        { printBoard(); }
+}
+
 bool NQueensBoard::recursiveSolve(const int& iCol)
 {
 	// Increment recursion count (just for analytics):
@@ -122,7 +227,8 @@ bool NQueensBoard::recursiveSolve(const int& iCol)
 	// Iterate over each row of the current column:
 	for(int r = 0; r < mTilesPerAxis; r++) {
 		// Place queen at the current row and column:
-		mBoard[r][iCol] = true;
+		mBoard[r][iCol]   = true;
+		mQueenRows[iCol] = r;
 		// Check if it is safe to place a queen
 		// in current row of the current column:
 		if( tileIsSafe( r, iCol ) ) {
@@ -131,8 +237,8 @@ bool NQueensBoard::recursiveSolve(const int& iCol)
             if( iCol == mTilesPerAxis - 1 ) {
 				// Increment the solution count:
 				mSolutionCount++;
-				// Print board:
-				printBoard();
+				// Output solution:
+				emitSolution();
 				// Add temporary call count to total (just for analytics):
 				mTotalCallCount += mTempCallCount;
 				// Reset the temporary call count:
@@ -147,4 +253,73 @@ bool NQueensBoard::recursiveSolve(const int& iCol)
 		mBoard[r][iCol] = false;
 	}
 	return false;
-}
\ No newline at end of file
+}
+
+void NQueensBoard::bitmaskSolve(const int& iCol, const uint32_t& iRows, const uint32_t& iDiagUp, const uint32_t& iDiagDown)
+{
+	// Increment recursion count (just for analytics):
+	mTempCallCount++;
+	// Find the rows of the current column that are not attacked:
+	uint32_t tAvailable = mFullMask & ~( iRows | iDiagUp | iDiagDown );
+	// When only counting, every available row of the final column is a solution:
+	if( mCountOnly && iCol == mTilesPerAxis - 1 ) {
+		mSolutionCount += __builtin_popcount( tAvailable );
+		return;
+	}
+	// Iterate over each available row, lowest first:
+	while( tAvailable ) {
+		uint32_t tBit = tAvailable & ( ~tAvailable + 1 );
+		tAvailable ^= tBit;
+		// If the current column index is the final one,
+		// then we have reached a solution state:
+		if( iCol == mTilesPerAxis - 1 ) {
+			// Increment the solution count:
+			mSolutionCount++;
+			if( !mCountOnly ) {
+				// Place queen, output solution, then un-place queen:
+				int tRow = __builtin_ctz( tBit );
+				mBoard[tRow][iCol] = true;
+				mQueenRows[iCol]   = tRow;
+				emitSolution();
+				mBoard[tRow][iCol] = false;
+				// Add temporary call count to total (just for analytics):
+				mTotalCallCount += mTempCallCount;
+				// Reset the temporary call count:
+				mTempCallCount = 0;
+			}
+		}
+		// Recursively search the next column, shifting each diagonal by one row:
+		else {
+			int tRow = __builtin_ctz( tBit );
+			if( !mCountOnly ) {
+				mBoard[tRow][iCol] = true;
+				mQueenRows[iCol]   = tRow;
+			}
+			bitmaskSolve( iCol + 1, iRows | tBit, ( ( iDiagUp | tBit ) << 1 ) & mFullMask, ( iDiagDown | tBit ) >> 1 );
+			if( !mCountOnly ) { mBoard[tRow][iCol] = false; }
+		}
+	}
+}
+
+uint64_t NQueensBoard::bitmaskCount(const int& iCol, const int& iTilesPerAxis, const uint32_t& iFullMask,
+									const uint32_t& iRows, const uint32_t& iDiagUp, const uint32_t& iDiagDown)
+{
+	// A full board is a solution:
+	if( iCol == iTilesPerAxis ) {
+		return 1;
+	}
+	// Find the rows of the current column that are not attacked:
+	uint32_t tAvailable = iFullMask & ~( iRows | iDiagUp | iDiagDown );
+	// Every available row of the final column is a solution:
+	if( iCol == iTilesPerAxis - 1 ) {
+		return __builtin_popcount( tAvailable );
+	}
+	// Recursively count each available row, lowest first:
+	uint64_t tCount = 0;
+	while( tAvailable ) {
+		uint32_t tBit = tAvailable & ( ~tAvailable + 1 );
+		tAvailable ^= tBit;
+		tCount += bitmaskCount( iCol + 1, iTilesPerAxis, iFullMask, iRows | tBit, ( ( iDiagUp | tBit ) << 1 ) & iFullMask, ( iDiagDown | tBit ) >> 1 );
+	}
+	return tCount;
+}
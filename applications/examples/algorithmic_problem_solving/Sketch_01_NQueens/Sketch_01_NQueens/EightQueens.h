@@ -9,6 +9,10 @@
 #pragma once
 
 #include <iostream>
+#include <cstdint>
+#include <vector>
+
+#include "SolutionSink.h"
 
 /**
  * @brief A recursive-backtracking solution to the N-Queens Puzzle
@@ -24,6 +28,20 @@ public:
 	/** @brief Finds and prints all possible solutions to the n-queens puzzle for the given board size */
 	void		solveWithBacktracking();
 	
+	/** @brief Finds all possible solutions using bitmask occupancy (N <= 32), printing each one unless iCountOnly is set */
+	void		solveWithBitmasks(const bool& iCountOnly = false);
+	
+	/** @brief Counts all solutions on iThreadCount threads (0 uses all cores). The search is split into tasks by the
+	 * placements in the first two columns. Only the upper half of the first column is searched, since mirroring a board
+	 * top to bottom maps each solution to another. */
+	void		countInParallel(const int& iThreadCount = 0);
+	
+	/** @brief Streams each solution found to the given sink instead of printing it (NULL restores printing). The sink must outlive the solve */
+	void		setSolutionSink(SolutionSink* iSink);
+	
+	/** @brief Returns the number of solutions found by the most recent solve */
+	uint64_t	getSolutionCount() const;
+	
 private:
 	/** @brief Returns true if a queen can be placed within the row occupied by ( iRow, iCol ) */
 	bool		rowIsSafe(const int& iRow, const int& iCol) const;
@@ -40,13 +58,28 @@ private:
 	/** @brief Prints an ascii representation of the current board state to the console */
 	void		printBoard() const;
 	
+	/** @brief Sends the current board to the solution sink, or prints it if no sink is set */
+	void		emitSolution();
+	
 	/** @brief The recursive function that handles queen placement and backtracking within the algorithm */
 	bool		recursiveSolve(const int& iCol);
 	
+	/** @brief Returns the number of solutions that extend the given partial board, without touching any member state */
+	static uint64_t	bitmaskCount(const int& iCol, const int& iTilesPerAxis, const uint32_t& iFullMask,
+								 const uint32_t& iRows, const uint32_t& iDiagUp, const uint32_t& iDiagDown);
+	
+	/** @brief The recursive bitmask search, where each mask marks the rows attacked in the current column by queens in previous columns */
+	void		bitmaskSolve(const int& iCol, const uint32_t& iRows, const uint32_t& iDiagUp, const uint32_t& iDiagDown);
+	
 	int			mTilesPerAxis;		//!< The number of tiles per axis in the two-dimensional board
 	bool**		mBoard;				//!< A two-dimensional dynamic bool array storing the board state
+	std::vector<int>	mQueenRows;	//!< The row of the queen in each filled column
+	SolutionSink*		mSink;		//!< The optional consumer of solutions
+	
+	uint32_t	mFullMask;			//!< A mask with one bit set per row
+	bool		mCountOnly;			//!< Flags whether the bitmask search skips printing solutions
 	
-	int			mSolutionCount;		//!< Stores the number of solutions for the current N
-	int			mTotalCallCount;	//!< Stores the total number of calls made while iterating all solutions for the current N
-	int			mTempCallCount;		//!< Stores the number of calls made during the current solution iteration
+	uint64_t	mSolutionCount;		//!< Stores the number of solutions for the current N
+	uint64_t	mTotalCallCount;	//!< Stores the total number of calls made while iterating all solutions for the current N
+	uint64_t	mTempCallCount;		//!< Stores the number of calls made during the current solution iteration
 };
\ No newline at end of file
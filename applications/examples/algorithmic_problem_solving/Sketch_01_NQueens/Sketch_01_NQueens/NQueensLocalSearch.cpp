@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#include "NQueensLocalSearch.h"
+
+#include <algorithm>
+
+using namespace std;
+
+NQueensLocalSearch::NQueensLocalSearch(int iTilesPerAxis, uint32_t iSeed)
+: mTilesPerAxis(iTilesPerAxis), mAttackCount(0), mSwapAttemptCount(0), mRandom(iSeed)
+{
+}
+
+bool NQueensLocalSearch::solve(const uint64_t& iMaxSwapAttempts)
+{
+	mSwapAttemptCount = 0;
+	initialize();
+	// Boards of size 2 and 3 have no solution:
+	if( mTilesPerAxis == 2 || mTilesPerAxis == 3 ) { return false; }
+	// Sweep over the columns, swapping each attacked queen with random partners until the attacks decrease:
+	uniform_int_distribution<int> tColumn( 0, max( mTilesPerAxis - 1, 0 ) );
+	int tTryCount = min( mTilesPerAxis, 256 );
+	while( mAttackCount > 0 ) {
+		uint64_t tSweepStart = mAttackCount;
+		for(int i = 0; i < mTilesPerAxis && mAttackCount > 0; i++) {
+			if( getAttacks( i ) == 0 ) { continue; }
+			for(int tTry = 0; tTry < tTryCount; tTry++) {
+				if( iMaxSwapAttempts > 0 && mSwapAttemptCount >= iMaxSwapAttempts ) { return false; }
+				mSwapAttemptCount++;
+				int j = tColumn( mRandom );
+				if( j == i ) { continue; }
+				// Keep the swap only if it reduces the number of attacks:
+				uint64_t tBefore = mAttackCount;
+				swapRows( i, j );
+				if( mAttackCount < tBefore ) { break; }
+				swapRows( i, j );
+			}
+		}
+		// Restart from a new random board if a whole sweep made no progress:
+		if( mAttackCount >= tSweepStart ) {
+			initialize();
+		}
+	}
+	return true;
+}
+
+const vector<int>& NQueensLocalSearch::getRows() const
+{
+	return mRows;
+}
+
+const uint64_t& NQueensLocalSearch::getAttackCount() const
+{
+	return mAttackCount;
+}
+
+const uint64_t& NQueensLocalSearch::getSwapAttemptCount() const
+{
+	return mSwapAttemptCount;
+}
+
+bool NQueensLocalSearch::isSolution() const
+{
+	// Rebuild the diagonal occupancy from scratch:
+	vector<bool> tUp( 2 * mTilesPerAxis, false );
+	vector<bool> tDown( 2 * mTilesPerAxis, false );
+	vector<bool> tRow( mTilesPerAxis, false );
+	for(int c = 0; c < mTilesPerAxis; c++) {
+		int r = mRows[ c ];
+		if( tRow[ r ] || tUp[ r + c ] || tDown[ r - c + mTilesPerAxis - 1 ] ) { return false; }
+		tRow[ r ] = tUp[ r + c ] = tDown[ r - c + mTilesPerAxis - 1 ] = true;
+	}
+	return true;
+}
+
+void NQueensLocalSearch::initialize()
+{
+	// Reset board:
+	mRows.resize( mTilesPerAxis );
+	for(int i = 0; i < mTilesPerAxis; i++) {
+		mRows[ i ] = i;
+	}
+	mDiagUp.assign( 2 * mTilesPerAxis, 0 );
+	mDiagDown.assign( 2 * mTilesPerAxis, 0 );
+	mAttackCount = 0;
+	// Fill each column with a random remaining row, retrying a few times for one whose diagonals are free:
+	for(int i = 0; i < mTilesPerAxis; i++) {
+		uniform_int_distribution<int> tRemaining( i, mTilesPerAxis - 1 );
+		for(int tTry = 0; tTry < 4; tTry++) {
+			swap( mRows[ i ], mRows[ tRemaining( mRandom ) ] );
+			int r = mRows[ i ];
+			if( mDiagUp[ r + i ] == 0 && mDiagDown[ r - i + mTilesPerAxis - 1 ] == 0 ) { break; }
+		}
+		updateDiagonals( mRows[ i ], i, 1 );
+	}
+}
+
+void NQueensLocalSearch::updateDiagonals(const int& iRow, const int& iCol, const int& iDelta)
+{
+	int& tUp   = mDiagUp[ iRow + iCol ];
+	int& tDown = mDiagDown[ iRow - iCol + mTilesPerAxis - 1 ];
+	// A queen added to a diagonal holding k queens adds k attacking pairs; removing one of k queens removes k - 1:
+	if( iDelta > 0 ) {
+		mAttackCount += tUp + tDown;
+		tUp++;
+		tDown++;
+	}
+	else {
+		tUp--;
+		tDown--;
+		mAttackCount -= tUp + tDown;
+	}
+}
+
+int NQueensLocalSearch::getAttacks(const int& iCol) const
+{
+	int r = mRows[ iCol ];
+	return ( mDiagUp[ r + iCol ] - 1 ) + ( mDiagDown[ r - iCol + mTilesPerAxis - 1 ] - 1 );
+}
+
+void NQueensLocalSearch::swapRows(const int& iColA, const int& iColB)
+{
+	updateDiagonals( mRows[ iColA ], iColA, -1 );
+	updateDiagonals( mRows[ iColB ], iColB, -1 );
+	swap( mRows[ iColA ], mRows[ iColB ] );
+	updateDiagonals( mRows[ iColA ], iColA, 1 );
+	updateDiagonals( mRows[ iColB ], iColB, 1 );
+}
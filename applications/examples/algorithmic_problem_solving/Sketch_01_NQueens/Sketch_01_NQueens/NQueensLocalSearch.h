@@ -0,0 +1,60 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief A min-conflicts local search for a single solution to the N-Queens Puzzle, suitable for boards with millions of tiles per axis.
+ * The board is encoded as a permutation (one queen per column, each in a distinct row), so only diagonal attacks are possible.
+ * Per-diagonal queen counters make each swap of two columns' rows, and the resulting change in attacks, an O(1) operation.
+ */
+class NQueensLocalSearch {
+public:
+	/** @brief Constructor for an N-Queens local search. Default: N = 8 */
+	NQueensLocalSearch(int iTilesPerAxis = 8, uint32_t iSeed = 5489u);
+
+	/** @brief Searches for a solution, giving up after iMaxSwapAttempts attempted swaps (0 = no limit). Returns true if a solution was found */
+	bool					solve(const uint64_t& iMaxSwapAttempts = 0);
+
+	/** @brief Returns the row of the queen in each column */
+	const std::vector<int>&	getRows() const;
+
+	/** @brief Returns the number of attacking queen pairs on the current board */
+	const uint64_t&			getAttackCount() const;
+
+	/** @brief Returns the number of swaps attempted by the most recent search */
+	const uint64_t&			getSwapAttemptCount() const;
+
+	/** @brief Returns true if the current board is a solution, checked independently of the diagonal counters */
+	bool					isSolution() const;
+
+private:
+	/** @brief Places the queens in a random permutation, preferring rows whose diagonals are still free */
+	void		initialize();
+
+	/** @brief Adds or removes the queen at ( iRow, iCol ) from the diagonal counters and updates the attack count */
+	void		updateDiagonals(const int& iRow, const int& iCol, const int& iDelta);
+
+	/** @brief Returns the number of other queens sharing a diagonal with the queen in column iCol */
+	int			getAttacks(const int& iCol) const;
+
+	/** @brief Swaps the rows of columns iColA and iColB */
+	void		swapRows(const int& iColA, const int& iColB);
+
+	int					mTilesPerAxis;		//!< The number of tiles per axis in the two-dimensional board
+	std::vector<int>	mRows;				//!< The row of the queen in each column
+	std::vector<int>	mDiagUp;			//!< The number of queens on each diagonal of constant row + column
+	std::vector<int>	mDiagDown;			//!< The number of queens on each diagonal of constant row - column
+	uint64_t			mAttackCount;		//!< The number of attacking queen pairs
+	uint64_t			mSwapAttemptCount;	//!< The number of swaps attempted by the most recent search
+	std::mt19937		mRandom;			//!< The random number generator
+};
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#include "SolutionSink.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+BufferedSolutionWriter::BufferedSolutionWriter(ostream& iStream, const Format& iFormat, const size_t& iBufferSize)
+: mStream(iStream), mFormat(iFormat), mBufferSize(iBufferSize)
+{
+	mBuffer.reserve( mBufferSize + 256 );
+}
+
+BufferedSolutionWriter::~BufferedSolutionWriter()
+{
+	flush();
+}
+
+void BufferedSolutionWriter::write(const int* iRows, const int& iTilesPerAxis)
+{
+	if( mFormat == TEXT ) {
+		// Append each row index in decimal:
+		char tDigits[ 16 ];
+		for(int i = 0; i < iTilesPerAxis; i++) {
+			int tLength = 0;
+			int tValue  = iRows[ i ];
+			do {
+				tDigits[ tLength++ ] = '0' + ( tValue % 10 );
+				tValue /= 10;
+			} while( tValue > 0 );
+			while( tLength > 0 ) {
+				mBuffer.push_back( tDigits[ --tLength ] );
+			}
+			mBuffer.push_back( ( i + 1 < iTilesPerAxis ) ? ' ' : '\n' );
+		}
+	}
+	else if( iTilesPerAxis <= 256 ) {
+		// Append one byte per row index:
+		for(int i = 0; i < iTilesPerAxis; i++) {
+			mBuffer.push_back( (char)(uint8_t)iRows[ i ] );
+		}
+	}
+	else {
+		// Append one native 32-bit integer per row index:
+		size_t tOffset = mBuffer.size();
+		mBuffer.resize( tOffset + iTilesPerAxis * sizeof( int32_t ) );
+		for(int i = 0; i < iTilesPerAxis; i++) {
+			int32_t tRow = iRows[ i ];
+			memcpy( &mBuffer[ tOffset + i * sizeof( int32_t ) ], &tRow, sizeof( int32_t ) );
+		}
+	}
+	// Write full buffer:
+	if( mBuffer.size() >= mBufferSize ) {
+		drain();
+	}
+}
+
+void BufferedSolutionWriter::flush()
+{
+	drain();
+	mStream.flush();
+}
+
+void BufferedSolutionWriter::drain()
+{
+	if( !mBuffer.empty() ) {
+		mStream.write( &mBuffer[ 0 ], mBuffer.size() );
+		mBuffer.clear();
+	}
+}
+
+CallbackSolutionSink::CallbackSolutionSink(const Callback& iCallback)
+: mCallback(iCallback)
+{
+}
+
+void CallbackSolutionSink::write(const int* iRows, const int& iTilesPerAxis)
+{
+	if( mCallback ) {
+		mCallback( iRows, iTilesPerAxis );
+	}
+}
@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief An abstract consumer of N-Queens solutions. Each solution is encoded compactly as the row of the queen in each column.
+ */
+class SolutionSink {
+public:
+	/** @brief Destructor */
+	virtual ~SolutionSink() {}
+	
+	/** @brief Receives a solution as iTilesPerAxis row indices, one per column */
+	virtual void	write(const int* iRows, const int& iTilesPerAxis) = 0;
+	
+	/** @brief Delivers any buffered solutions */
+	virtual void	flush() {}
+};
+
+/**
+ * @brief A solution sink that accumulates encoded solutions in a memory buffer and writes them to an output stream in large blocks
+ */
+class BufferedSolutionWriter : public SolutionSink {
+public:
+	/** @brief An enumeration of the available output encodings */
+	enum Format {
+		TEXT,	//!< One line per solution, with row indices separated by spaces
+		BINARY	//!< One record per solution, with each row index stored in a single byte (N <= 256) or as a native 32-bit integer
+	};
+	
+	/** @brief Constructor. The stream must outlive the writer */
+	BufferedSolutionWriter(std::ostream& iStream, const Format& iFormat = TEXT, const size_t& iBufferSize = 1 << 16);
+	
+	/** @brief Destructor (flushes any buffered solutions) */
+	~BufferedSolutionWriter();
+	
+	/** @brief Encodes a solution into the buffer, writing the buffer to the stream once it is full */
+	void		write(const int* iRows, const int& iTilesPerAxis);
+	
+	/** @brief Writes the buffer to the stream and flushes the stream */
+	void		flush();
+	
+private:
+	/** @brief Writes the buffer to the stream without flushing the stream */
+	void		drain();
+	
+	std::ostream&		mStream;		//!< The output stream
+	Format				mFormat;		//!< The output encoding
+	std::vector<char>	mBuffer;		//!< The encoded solutions awaiting output
+	size_t				mBufferSize;	//!< The buffer size at which the buffer is written to the stream
+};
+
+/**
+ * @brief A solution sink that forwards each solution to a callback
+ */
+class CallbackSolutionSink : public SolutionSink {
+public:
+	typedef std::function<void(const int*, const int&)>	Callback;
+	
+	/** @brief Constructor */
+	CallbackSolutionSink(const Callback& iCallback);
+	
+	/** @brief Forwards a solution to the callback */
+	void		write(const int* iRows, const int& iTilesPerAxis);
+	
+private:
+	Callback	mCallback;		//!< The solution consumer
+};
@@ -43,18 +43,127 @@
  */
 
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <climits>
+#include <chrono>
+#include <fstream>
 
 #include "EightQueens.h"
+#include "NQueensLocalSearch.h"
 
 using namespace std;
 
+/**
+ * @brief Prints the command line usage
+ */
+static void printUsage(const char* iProgram)
+{
+	cout << "Usage: " << iProgram << " [N] [--bitmask] [--count] [--parallel] [--threads T] [--min-conflicts] [--seed S] [--output FILE] [--binary FILE]" << endl;
+	cout << "\tN must be at least 1 (and at most 32 for --bitmask, --count, --parallel and --threads)." << endl;
+}
+
 int main(int argc, const char * argv[])
 {
-	NQueensBoard* tBoard = new NQueensBoard( 8 );
+	// Parse arguments: [N] [--bitmask] [--count] [--parallel] [--threads T] [--min-conflicts] [--seed S] [--output FILE] [--binary FILE]
+	int  tTilesPerAxis = 8;
+	bool tBitmask      = false;
+	bool tCountOnly    = false;
+	bool tParallel     = false;
+	int  tThreadCount  = 0;
+	bool tMinConflicts = false;
+	int  tSeed         = 5489;
+	string tOutputPath;
+	BufferedSolutionWriter::Format tOutputFormat = BufferedSolutionWriter::TEXT;
+	for(int i = 1; i < argc; i++) {
+		string tArg( argv[ i ] );
+		if( tArg == "--bitmask" )       { tBitmask = true; }
+		else if( tArg == "--count" )    { tBitmask = tCountOnly = true; }
+		else if( tArg == "--parallel" ) { tParallel = true; }
+		else if( tArg == "--threads" && i + 1 < argc ) {
+			tParallel    = true;
+			tThreadCount = atoi( argv[ ++i ] );
+		}
+		else if( tArg == "--min-conflicts" ) { tMinConflicts = true; }
+		else if( tArg == "--seed" && i + 1 < argc ) { tSeed = atoi( argv[ ++i ] ); }
+		else if( ( tArg == "--output" || tArg == "--binary" ) && i + 1 < argc ) {
+			tOutputPath   = argv[ ++i ];
+			tOutputFormat = ( tArg == "--binary" ) ? BufferedSolutionWriter::BINARY : BufferedSolutionWriter::TEXT;
+		}
+		else {
+			// Any other argument must be the board size:
+			char* tEnd  = NULL;
+			long  tSize = strtol( argv[ i ], &tEnd, 10 );
+			if( tEnd == argv[ i ] || *tEnd != '\0' ) {
+				cout << "ERROR: Unknown argument \'" << tArg << "\'." << endl;
+				printUsage( argv[ 0 ] );
+				return 1;
+			}
+			if( tSize < 1 || tSize > INT_MAX ) {
+				cout << "ERROR: N must be at least 1." << endl;
+				printUsage( argv[ 0 ] );
+				return 1;
+			}
+			tTilesPerAxis = (int)tSize;
+		}
+	}
+	
+	// The bitmask engine holds one bit per row:
+	if( ( tBitmask || tParallel ) && !tMinConflicts && tTilesPerAxis > 32 ) {
+		cout << "ERROR: N must be at most 32 for the bitmask engine." << endl;
+		printUsage( argv[ 0 ] );
+		return 1;
+	}
+	
+	// Only the enumerating solvers stream solutions, so reject a sink for any other mode:
+	if( !tOutputPath.empty() && ( tCountOnly || tParallel || tMinConflicts ) ) {
+		cout << "ERROR: --output and --binary cannot be combined with --count, --parallel, --threads or --min-conflicts." << endl;
+		return 1;
+	}
+	
+	// Find a single solution by local search:
+	if( tMinConflicts ) {
+		NQueensLocalSearch tSearch( tTilesPerAxis, tSeed );
+		chrono::steady_clock::time_point tStart = chrono::steady_clock::now();
+		bool tSolved = tSearch.solve();
+		double tSeconds = chrono::duration<double>( chrono::steady_clock::now() - tStart ).count();
+		if( tSolved && tSearch.isSolution() ) {
+			cout << "Found a solution for N = " << tTilesPerAxis << " in " << tSeconds << " seconds (" << tSearch.getSwapAttemptCount() << " swap attempts)" << endl;
+			// Print small boards as one row index per column:
+			if( tTilesPerAxis <= 64 ) {
+				for(int i = 0; i < tTilesPerAxis; i++) {
+					cout << tSearch.getRows()[ i ] << ( i + 1 < tTilesPerAxis ? " " : "\n" );
+				}
+			}
+		}
+		else {
+			cout << "No solution found for N = " << tTilesPerAxis << endl;
+		}
+		return 0;
+	}
+	
+	NQueensBoard* tBoard = new NQueensBoard( tTilesPerAxis );
+	
+	// Stream solutions to a file, if requested:
+	ofstream                tOutputFile;
+	BufferedSolutionWriter* tWriter = NULL;
+	if( !tOutputPath.empty() ) {
+		tOutputFile.open( tOutputPath.c_str(), ios::out | ios::binary );
+		if( !tOutputFile.is_open() ) {
+			cout << "ERROR: Cannot open output file \'" << tOutputPath << "\'." << endl;
+			delete tBoard;
+			return 1;
+		}
+		tWriter = new BufferedSolutionWriter( tOutputFile, tOutputFormat );
+		tBoard->setSolutionSink( tWriter );
+	}
 	
-	tBoard->solveWithBacktracking();
+	if( tParallel )     { tBoard->countInParallel( tThreadCount ); }
+	else if( tBitmask ) { tBoard->solveWithBitmasks( tCountOnly ); }
+	else                { tBoard->solveWithBacktracking(); }
 	
 	delete tBoard;
+	delete tWriter;
 	
     return 0;
 }
@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @brief A fixed-capacity, thread-safe FIFO queue. Producers block while the queue is full and
+ * consumers block while it is empty, until the queue is closed.
+ */
+template <class ItemType>
+class BoundedQueue {
+protected:
+	std::deque<ItemType>		mItems;
+	size_t						mCapacity;
+	bool						mClosed;
+	std::mutex					mMutex;
+	std::condition_variable		mNotEmpty;
+	std::condition_variable		mNotFull;
+
+public:
+
+	/**
+	 * @brief BoundedQueue constructor
+	 */
+	BoundedQueue(const size_t& iCapacity = 1) :
+		mCapacity( std::max( iCapacity, (size_t)1 ) ),
+		mClosed( false )
+	{
+	}
+
+	/**
+	 * @brief Empties and reopens the queue with the given capacity. Must not be called while other threads are using it.
+	 */
+	void reset(const size_t& iCapacity)
+	{
+		std::lock_guard<std::mutex> tLock( mMutex );
+		mItems.clear();
+		mCapacity = std::max( iCapacity, (size_t)1 );
+		mClosed   = false;
+	}
+
+	/**
+	 * @brief Appends an item, waiting for space if the queue is full. Returns false if the queue has been closed.
+	 */
+	bool push(const ItemType& iItem)
+	{
+		std::unique_lock<std::mutex> tLock( mMutex );
+		mNotFull.wait( tLock, [this]() { return mClosed || mItems.size() < mCapacity; } );
+		if( mClosed ) {
+			return false;
+		}
+		mItems.push_back( iItem );
+		tLock.unlock();
+		mNotEmpty.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief Removes the oldest item, waiting for one if the queue is empty. Returns false if the queue has been closed.
+	 */
+	bool pop(ItemType& oItem)
+	{
+		std::unique_lock<std::mutex> tLock( mMutex );
+		mNotEmpty.wait( tLock, [this]() { return mClosed || !mItems.empty(); } );
+		if( mClosed ) {
+			return false;
+		}
+		oItem = mItems.front();
+		mItems.pop_front();
+		tLock.unlock();
+		mNotFull.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief Closes the queue, releasing all waiting producers and consumers
+	 */
+	void close()
+	{
+		{
+			std::lock_guard<std::mutex> tLock( mMutex );
+			mClosed = true;
+		}
+		mNotEmpty.notify_all();
+		mNotFull.notify_all();
+	}
+};
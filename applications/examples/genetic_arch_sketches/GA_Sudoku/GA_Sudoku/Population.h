@@ -13,19 +13,83 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <thread>
 
 #include "Constants.h"
+#include "BoundedQueue.h"
 
 inline float map(const float& iValue, const float& iInStart, const float& iInStop, const float& iOutStart, const float& iOutStop)
 {
     return iOutStart + ( iOutStop - iOutStart ) * ( ( iValue - iInStart ) / ( iInStop - iInStart ) );
 }
 
+/**
+ * @brief Returns the calling thread's random generator state, so that concurrent test rounds draw isolated streams
+ */
+inline uint32_t& randomState()
+{
+	static thread_local uint32_t sState = 2463534242u;
+	return sState;
+}
+
+inline void randomSeed(const uint32_t& iSeed)
+{
+	// Scramble the seed so that consecutive seeds give unrelated streams (the state must be non-zero):
+	uint32_t tState = ( iSeed ^ 0x9E3779B9u ) * 0x85EBCA6Bu;
+	randomState() = ( tState != 0 ) ? tState : 2463534242u;
+}
+
+inline uint32_t randomNext()
+{
+	// Xorshift32:
+	uint32_t& tState = randomState();
+	tState ^= tState << 13;
+	tState ^= tState >> 17;
+	tState ^= tState << 5;
+	return tState;
+}
+
+inline float randomUnit()
+{
+	return (float)( randomNext() >> 8 ) / 16777216.0f;
+}
+
 inline int randomInt(const int& iMin, const int& iMax)
 {
-	return ( iMin + rand() % (iMax - iMin) );
+	return ( iMin + randomNext() % (iMax - iMin) );
+}
+
+inline float randomGaussian()
+{
+	// Box-Muller transform:
+	float tU = ( (float)( randomNext() >> 8 ) + 1.0f ) / 16777217.0f;
+	float tV = ( (float)( randomNext() >> 8 ) + 1.0f ) / 16777217.0f;
+	return std::sqrt( -2.0f * std::log( tU ) ) * std::cos( 6.2831853f * tV );
 }
 
+/**
+ * @brief An enumeration of the responses available when a population stagnates
+ */
+enum StagnationAction
+{
+	STAGNATION_IGNORE,		//!< Take no action
+	STAGNATION_STOP,		//!< Stop the evolutionary process
+	STAGNATION_IMMIGRANTS,	//!< Replace a portion of the population with freshly initialized individuals
+	STAGNATION_MUTATION		//!< Raise the mutation rate until the population improves again
+};
+
+/**
+ * @brief An enumeration of the available mutation rate controllers
+ */
+enum MutationControl
+{
+	MUTATION_FIXED,			//!< The mutation rate remains constant
+	MUTATION_ONE_FIFTH,		//!< The rate rises while more than a fifth of the children outscore their parents and falls otherwise
+	MUTATION_DIVERSITY,		//!< The rate rises as the mean allele entropy falls (requires an allele range)
+	MUTATION_SELF_ADAPTIVE	//!< Each individual carries its own rate, which is inherited and perturbed log-normally
+};
+
 /**
  * @brief A templated GA container and facilitator
  */
@@ -36,42 +100,126 @@ public:
 	typedef std::function<float(const DataType*, const size_t&)>								FitnessFunction;
 	typedef std::function<void(const DataType*, const DataType*, DataType*, const size_t&)>		CrossoverFunction;
 	typedef std::function<void(DataType*, const size_t&, const float&)>							MutationFunction;
+	typedef std::function<float(DataType*, const size_t&, const float&)>						ScoringMutationFunction;
 	typedef std::function<void(DataType*, const size_t&)>										PrintFunction;
+	typedef std::function<bool(const DataType*, const size_t&)>									WinFunction;
+	typedef std::pair<float,size_t>																ScoreIndex;
+	
+	/**
+	 * @brief A unit of work passed between the master and the evaluation workers
+	 */
+	struct EvaluationTask {
+		std::vector<DataType>	mGenes;
+		float					mScore;
+		float					mParentScore;
+		float					mRate;
+		size_t					mTargetIdx;
+	};
 	
 protected:
 	InitializeFunction		mInitializeFunction;
 	FitnessFunction			mFitnessFunction;
 	CrossoverFunction		mCrossoverFunction;
 	MutationFunction		mMutationFunction;
+	ScoringMutationFunction	mScoringMutationFunction;
 	PrintFunction			mPrintFunction;
+	WinFunction				mWinFunction;
 	
 	DataType**				mPopulation;
 	size_t					mPopulationSize;
 	size_t					mGeneCount;
 	size_t					mGenerationIter;
 	float					mMutationRate;
+	float					mMutationRateBase;
 	bool					mRunning;
 	
 	DataType*				mWinState;
 	
+	size_t					mStagnationWindow;
+	float					mStagnationEpsilon;
+	float					mDiversityThreshold;
+	StagnationAction		mStagnationAction;
+	float					mStagnationParam;
+	size_t					mStagnantGenerations;
+	float					mBestScoreRecord;
+	float					mAvgScoreRecord;
+	bool					mStagnated;
+	
+	int						mAlleleMin;
+	int						mAlleleCount;
+	std::vector<size_t>		mAlleleHistogram;
+	std::vector<float>		mLocusEntropy;
+	float					mMeanEntropy;
+	float					mMeanDistance;
+	
+	MutationControl			mMutationControl;
+	float					mMutationRateMin;
+	float					mMutationRateMax;
+	std::vector<float>		mParentScores;
+	std::vector<float>		mIndividualRates;
+	
+	size_t					mOffspringCount;
+	DataType**				mOffspring;
+	std::vector<float>		mOffspringScores;
+	std::vector<float>		mOffspringParentScores;
+	std::vector<float>		mOffspringRates;
+	std::vector<float>		mScores;
+	std::vector<float>		mCachedScores;
+	std::vector<ScoreIndex>	mWorstHeap;
+	size_t					mBestIdx;
+	size_t					mEvaluationCount;
+	size_t					mSuccessCount;
+	
+	size_t								mWorkerCount;
+	std::vector<std::thread>			mWorkers;
+	std::vector<EvaluationTask>			mTasks;
+	std::vector<EvaluationTask*>		mFreeTasks;
+	BoundedQueue<EvaluationTask*>		mTaskQueue;
+	BoundedQueue<EvaluationTask*>		mResultQueue;
+	
 public:
 
 	/**
 	 * @brief Population constructor
 	 */
 	Population(const size_t& iPopulationSize, const size_t& iGeneCount, const float& iMutationRate) :
+		mInitializeFunction( NULL ),
+		mFitnessFunction( NULL ),
+		mCrossoverFunction( NULL ),
+		mMutationFunction( NULL ),
+		mScoringMutationFunction( NULL ),
+		mPrintFunction( NULL ),
+		mWinFunction( NULL ),
+		mPopulation( NULL ),
 		mPopulationSize( iPopulationSize ),
 		mGeneCount( iGeneCount ),
-		mMutationRate( iMutationRate ),
 		mGenerationIter( 0 ),
+		mMutationRate( iMutationRate ),
+		mMutationRateBase( iMutationRate ),
 		mRunning( true ),
-		mPopulation( NULL ),
 		mWinState( NULL ),
-		mInitializeFunction( NULL ),
-		mFitnessFunction( NULL ),
-		mCrossoverFunction( NULL ),
-		mMutationFunction( NULL ),
-		mPrintFunction( NULL )
+		mStagnationWindow( 0 ),
+		mStagnationEpsilon( 0.0f ),
+		mDiversityThreshold( 0.0f ),
+		mStagnationAction( STAGNATION_IGNORE ),
+		mStagnationParam( 0.0f ),
+		mStagnantGenerations( 0 ),
+		mBestScoreRecord( -1e12 ),
+		mAvgScoreRecord( -1e12 ),
+		mStagnated( false ),
+		mAlleleMin( 0 ),
+		mAlleleCount( 0 ),
+		mMeanEntropy( 0.0f ),
+		mMeanDistance( 0.0f ),
+		mMutationControl( MUTATION_FIXED ),
+		mMutationRateMin( iMutationRate ),
+		mMutationRateMax( iMutationRate ),
+		mOffspringCount( 0 ),
+		mOffspring( NULL ),
+		mBestIdx( 0 ),
+		mEvaluationCount( 0 ),
+		mSuccessCount( 0 ),
+		mWorkerCount( 0 )
 	{
 	}
 	
@@ -80,6 +228,8 @@ public:
 	 */
 	~Population()
 	{
+		// Stop evaluation workers:
+		stopWorkers();
 		// Delete population:
 		if( mPopulation ) {
 			for(int i = 0; i < mPopulationSize; i++) {
@@ -93,6 +243,8 @@ public:
 			delete [] mWinState;
 			mWinState = NULL;
 		}
+		// Delete offspring buffers:
+		setSteadyState( 0 );
 	}
 	
 	/**
@@ -127,6 +279,17 @@ public:
 		mMutationFunction = iFunc;
 	}
 	
+	/**
+	 * @brief Binds an external mutation function that also returns the mutated child's score, typically by updating
+	 * the score incrementally. When bound, it replaces the mutation function and the child is not passed to the
+	 * fitness function again. Asynchronous evaluation passes children scored this way straight back for integration
+	 * rather than queueing them for the workers.
+	 */
+	void setScoringMutationFunction(ScoringMutationFunction iFunc)
+	{
+		mScoringMutationFunction = iFunc;
+	}
+	
 	/**
 	 * @brief Binds an external printer function
 	 */
@@ -135,6 +298,116 @@ public:
 		mPrintFunction = iFunc;
 	}
 	
+	/**
+	 * @brief Binds an external win state function, which replaces getBoardWin() as the stopping criterion
+	 */
+	void setWinFunction(WinFunction iFunc)
+	{
+		mWinFunction = iFunc;
+	}
+	
+	/**
+	 * @brief Sets the stagnation criteria. The population is considered stagnant once neither its best nor its
+	 * average score has improved by more than iEpsilon for iWindow generations, or as soon as the standard deviation
+	 * of its scores falls below iDiversityThreshold. A window of zero disables stagnation detection.
+	 */
+	void setStagnationCriteria(const size_t& iWindow, const float& iEpsilon = 0.0f, const float& iDiversityThreshold = 0.0f)
+	{
+		mStagnationWindow    = iWindow;
+		mStagnationEpsilon   = iEpsilon;
+		mDiversityThreshold  = iDiversityThreshold;
+		mStagnantGenerations = 0;
+	}
+	
+	/**
+	 * @brief Sets the response to stagnation. For STAGNATION_IMMIGRANTS, iParam is the fraction of the population
+	 * to be replaced. For STAGNATION_MUTATION, iParam is the multiplier applied to the mutation rate; a multiplier
+	 * of 1 or less (including the default) would not raise the rate, so it is replaced by 2.
+	 */
+	void setStagnationAction(const StagnationAction& iAction, const float& iParam = 0.0f)
+	{
+		mStagnationAction = iAction;
+		mStagnationParam  = iParam;
+		// Fall back to doubling the mutation rate if the multiplier would not raise it:
+		if( iAction == STAGNATION_MUTATION && iParam <= 1.0f ) {
+			mStagnationParam = 2.0f;
+		}
+	}
+	
+	/**
+	 * @brief Enables per-locus diversity tracking for alleles in the inclusive range [ iMin, iMax ].
+	 * Alleles outside of this range are not counted.
+	 */
+	void setAlleleRange(const int& iMin, const int& iMax)
+	{
+		mAlleleMin   = iMin;
+		mAlleleCount = std::max( iMax - iMin + 1, 0 );
+		mAlleleHistogram.assign( mGeneCount * mAlleleCount, 0 );
+		mLocusEntropy.assign( mGeneCount, 0.0f );
+	}
+	
+	/**
+	 * @brief Sets the mutation rate controller, which keeps the rate within [ iMinRate, iMaxRate ]
+	 */
+	void setMutationControl(const MutationControl& iControl, const float& iMinRate, const float& iMaxRate)
+	{
+		mMutationControl = iControl;
+		mMutationRateMin = std::min( iMinRate, iMaxRate );
+		mMutationRateMax = std::max( iMinRate, iMaxRate );
+		mMutationRate    = std::min( std::max( mMutationRateBase, mMutationRateMin ), mMutationRateMax );
+		mParentScores.clear();
+		mIndividualRates.assign( mPopulationSize, mMutationRate );
+	}
+	
+	/**
+	 * @brief Switches between the generational model (iOffspringCount = 0) and the steady-state model, in which
+	 * each call to runGeneration() breeds iOffspringCount children and copies each one over the current worst member,
+	 * provided that the child scores at least as well. The worst member is tracked with a min-heap on fitness.
+	 * Parents are chosen by binary tournament, which does not depend on the population-wide score range.
+	 */
+	void setSteadyState(const size_t& iOffspringCount)
+	{
+		// Delete previous offspring buffers:
+		if( mOffspring ) {
+			for(size_t i = 0; i < mOffspringCount; i++) {
+				delete [] mOffspring[ i ];
+			}
+			delete [] mOffspring;
+			mOffspring = NULL;
+		}
+		// Allocate offspring buffers, which are reused by every step:
+		mOffspringCount = std::min( iOffspringCount, mPopulationSize );
+		if( mOffspringCount > 0 ) {
+			mOffspring = new DataType*[ mOffspringCount ];
+			for(size_t i = 0; i < mOffspringCount; i++) {
+				mOffspring[ i ] = new DataType[ mGeneCount ];
+			}
+		}
+		mOffspringScores.assign( mOffspringCount, 0.0f );
+		mOffspringParentScores.assign( mOffspringCount, 0.0f );
+		mOffspringRates.assign( mOffspringCount, 0.0f );
+		mScores.clear();
+	}
+	
+	/**
+	 * @brief Enables asynchronous evaluation on iWorkerCount threads (0 disables it). The master keeps up to
+	 * iQueueCapacity children in flight and integrates each result as soon as it completes, using steady-state
+	 * replacement, so no generational barrier waits on slow evaluations. The fitness function must be safe to
+	 * call concurrently; all other hooks run on the calling thread.
+	 */
+	void setAsyncEvaluation(const size_t& iWorkerCount, const size_t& iQueueCapacity = 0)
+	{
+		stopWorkers();
+		mWorkerCount = iWorkerCount;
+		// Allocate task buffers, which are reused by every evaluation:
+		size_t tCapacity = ( iQueueCapacity > 0 ) ? std::max( iQueueCapacity, iWorkerCount ) : ( iWorkerCount * 2 );
+		mTasks.assign( ( iWorkerCount > 0 ) ? tCapacity : 0, EvaluationTask() );
+		for(size_t i = 0; i < mTasks.size(); i++) {
+			mTasks[ i ].mGenes.resize( mGeneCount );
+		}
+		mScores.clear();
+	}
+	
 	/**
 	 * @brief Initializes the genetic population
 	 */
@@ -155,15 +428,25 @@ public:
 	 */
 	void runGeneration()
 	{
-		if( mFitnessFunction ) {
+		if( mWorkerCount > 0 ) {
+			runAsyncStep();
+		}
+		else if( mOffspringCount > 0 ) {
+			runSteadyStateStep();
+		}
+		else if( mFitnessFunction ) {
 			// Prepare scoring variables:
 			float  tScores[ mPopulationSize ];
 			size_t tBestIdx    = 0;
 			float  tBestScore  = -1e12;
 			float  tWorstScore = 1e12;
+			float  tScoreSum   = 0.0;
+			float  tScoreSqSum = 0.0;
 			// Perform scoring:
 			for(size_t i = 0; i < mPopulationSize; i++) {
-				tScores[ i ] = mFitnessFunction( mPopulation[ i ], mGeneCount );
+				tScores[ i ] = ( mCachedScores.size() == mPopulationSize ) ? mCachedScores[ i ] : mFitnessFunction( mPopulation[ i ], mGeneCount );
+				tScoreSum   += tScores[ i ];
+				tScoreSqSum += tScores[ i ] * tScores[ i ];
 				if( tScores[ i ] > tBestScore ) {
 					tBestScore = tScores[ i ];
 					tBestIdx   = i;
@@ -172,22 +455,27 @@ public:
 					tWorstScore = tScores[ i ];
 				}
 			}
-			// Check whether best individual is complete:
-			if( getBoardWin( mPopulation[ tBestIdx ], mGeneCount ) ) {
-				// Copy win state:
-				mWinState = new DataType[ mGeneCount ];
-				std::copy( mPopulation[ tBestIdx ], mPopulation[ tBestIdx ] + mGeneCount, mWinState );
-				// Set stop flag:
-				mRunning = false;
+			// Count children that outscored their best parent:
+			float tSuccessRatio = -1.0f;
+			if( mParentScores.size() == mPopulationSize ) {
+				size_t tSuccesses = 0;
+				for(size_t i = 0; i < mPopulationSize; i++) {
+					if( tScores[ i ] > mParentScores[ i ] ) { tSuccesses++; }
+				}
+				tSuccessRatio = (float)tSuccesses / (float)mPopulationSize;
+			}
+			// Update statistics and check stopping conditions:
+			if( !completeGeneration( tBestIdx, tBestScore, tScoreSum, tScoreSqSum, tSuccessRatio ) ) {
+				return;
 			}
 			// Handle mating:
-			else if( mCrossoverFunction && mMutationFunction ) {
-				std::vector<DataType*> tPool;
+			if( mCrossoverFunction && ( mMutationFunction || mScoringMutationFunction ) ) {
+				std::vector<size_t> tPool;
 				// Add individuals to pool:
 				for(int i = 0; i < mPopulationSize; i++) {
 					int tN = map( tScores[i], tWorstScore, tBestScore, 1.0f, 100.0f );
 					for(int j = 0; j < tN; j++) {
-						tPool.push_back( mPopulation[ i ] );
+						tPool.push_back( i );
 					}
 				}
 				// Check pool size:
@@ -199,12 +487,29 @@ public:
 				}
 				// Initialize new population:
 				DataType** tPopulation = new DataType*[ mPopulationSize ];
+				std::vector<float> tParentScores( mPopulationSize );
+				std::vector<float> tRates( mIndividualRates.size() );
+				std::vector<float> tCachedScores( mScoringMutationFunction ? mPopulationSize : 0 );
 				// Create a new population:
 				for(int i = 0; i < mPopulationSize; i++) {
+					size_t tIdxA = tPool.at( randomInt( 0, tPoolSize ) );
+					size_t tIdxB = tPool.at( randomInt( 0, tPoolSize ) );
 					tPopulation[ i ] = new DataType[ mGeneCount ];
-					mCrossoverFunction( tPool.at( randomInt( 0, tPoolSize ) ), tPool.at( randomInt( 0, tPoolSize ) ), tPopulation[ i ], mGeneCount );
-					mMutationFunction( tPopulation[ i ], mGeneCount, mMutationRate );
+					mCrossoverFunction( mPopulation[ tIdxA ], mPopulation[ tIdxB ], tPopulation[ i ], mGeneCount );
+					tParentScores[ i ] = std::max( tScores[ tIdxA ], tScores[ tIdxB ] );
+					// Apply mutation at the child's own rate, if self-adaptive:
+					float tRate = mMutationRate;
+					if( mMutationControl == MUTATION_SELF_ADAPTIVE ) {
+						tRates[ i ] = tRate = inheritMutationRate( mIndividualRates[ tIdxA ], mIndividualRates[ tIdxB ] );
+					}
+					float tScore = 0.0f;
+					if( mutateOffspring( tPopulation[ i ], tRate, tScore ) ) {
+						tCachedScores[ i ] = tScore;
+					}
 				}
+				mParentScores.swap( tParentScores );
+				mIndividualRates.swap( tRates );
+				mCachedScores.swap( tCachedScores );
 				// Delete previous population:
 				for(int i = 0; i < mPopulationSize; i++) {
 					delete [] mPopulation[ i ];
@@ -213,6 +518,16 @@ public:
 				mPopulation = NULL;
 				// Set new population:
 				mPopulation = tPopulation;
+				// Replace a portion of the population with immigrants, if stagnant:
+				if( mStagnated && mStagnationAction == STAGNATION_IMMIGRANTS && mInitializeFunction ) {
+					size_t tCount = std::min( (size_t)( mStagnationParam * mPopulationSize ), mPopulationSize );
+					for(size_t i = 0; i < tCount; i++) {
+						mInitializeFunction( mPopulation[ i ], mGeneCount );
+						if( i < mCachedScores.size() ) {
+							mCachedScores[ i ] = mFitnessFunction( mPopulation[ i ], mGeneCount );
+						}
+					}
+				}
 				// Advance generation iter:
 				mGenerationIter++;
 			}
@@ -233,6 +548,14 @@ public:
 		}
 	}
 	
+	/**
+	 * @brief Returns the saved win state, or NULL if none has been found
+	 */
+	const DataType* getWinState() const
+	{
+		return mWinState;
+	}
+	
 	/**
 	 * @brief Returns true if the GA has produced a Sudoku win state, otherwise false
 	 */
@@ -241,6 +564,56 @@ public:
 		return mRunning;
 	}
 	
+	/**
+	 * @brief Returns true if the most recent stagnation check was triggered
+	 */
+	bool isStagnated() const
+	{
+		return mStagnated;
+	}
+	
+	/**
+	 * @brief Returns the current mutation rate
+	 */
+	const float& getMutationRate() const
+	{
+		return mMutationRate;
+	}
+	
+	/**
+	 * @brief Returns the frequency of the given allele at the given locus, as of the most recent generation
+	 */
+	float getAlleleFrequency(const size_t& iLocus, const int& iAllele) const
+	{
+		int tIdx = iAllele - mAlleleMin;
+		if( iLocus >= mGeneCount || tIdx < 0 || tIdx >= mAlleleCount ) { return 0.0f; }
+		return (float)mAlleleHistogram[ iLocus * mAlleleCount + tIdx ] / (float)mPopulationSize;
+	}
+	
+	/**
+	 * @brief Returns the normalized Shannon entropy (0 to 1) of the allele distribution at the given locus
+	 */
+	float getLocusEntropy(const size_t& iLocus) const
+	{
+		return ( iLocus < mLocusEntropy.size() ) ? mLocusEntropy[ iLocus ] : 0.0f;
+	}
+	
+	/**
+	 * @brief Returns the normalized allele entropy (0 to 1) averaged over all loci
+	 */
+	const float& getMeanEntropy() const
+	{
+		return mMeanEntropy;
+	}
+	
+	/**
+	 * @brief Returns the mean pairwise Hamming distance between individuals, as a fraction of the gene count
+	 */
+	const float& getMeanDistance() const
+	{
+		return mMeanDistance;
+	}
+	
 	/**
 	 * @brief Returns the current generation number
 	 */
@@ -248,4 +621,441 @@ public:
 	{
 		return mGenerationIter;
 	}
+	
+protected:
+	
+	/**
+	 * @brief Applies the bookkeeping shared by both generation models: diversity metrics, mutation rate control,
+	 * the win check and the stagnation check. Returns false if the evolutionary process should stop.
+	 */
+	bool completeGeneration(const size_t& iBestIdx, const float& iBestScore, const float& iScoreSum, const float& iScoreSqSum, const float& iSuccessRatio)
+	{
+		// Update diversity metrics:
+		updateDiversity();
+		// Update mutation rate:
+		updateMutationRate( iSuccessRatio );
+		// Check whether best individual is complete:
+		if( checkWinState( iBestIdx ) ) {
+			return false;
+		}
+		// Check whether the population has stagnated:
+		if( updateStagnation( iBestScore, iScoreSum, iScoreSqSum ) && mStagnationAction == STAGNATION_STOP ) {
+			// Set stop flag:
+			mRunning = false;
+			return false;
+		}
+		return true;
+	}
+	
+	/**
+	 * @brief Checks whether the given individual is complete and, if so, saves the win state and stops the process.
+	 * Returns true without checking once a win state has been saved.
+	 */
+	bool checkWinState(const size_t& iIdx)
+	{
+		// A win state has already been saved:
+		if( mWinState ) {
+			return true;
+		}
+		bool tWin = mWinFunction ? mWinFunction( mPopulation[ iIdx ], mGeneCount ) : getBoardWin( mPopulation[ iIdx ], mGeneCount );
+		if( tWin ) {
+			// Copy win state:
+			mWinState = new DataType[ mGeneCount ];
+			std::copy( mPopulation[ iIdx ], mPopulation[ iIdx ] + mGeneCount, mWinState );
+			// Set stop flag:
+			mRunning = false;
+			return true;
+		}
+		return false;
+	}
+	
+	/**
+	 * @brief Runs a single steady-state step: breeds and scores the offspring, then replaces the worst members in place
+	 */
+	void runSteadyStateStep()
+	{
+		if( !mFitnessFunction || !mCrossoverFunction || !( mMutationFunction || mScoringMutationFunction ) || !mPopulation ) { return; }
+		// Score the whole population once:
+		if( mScores.size() != mPopulationSize ) {
+			mScores.resize( mPopulationSize );
+			for(size_t i = 0; i < mPopulationSize; i++) {
+				mScores[ i ] = mFitnessFunction( mPopulation[ i ], mGeneCount );
+			}
+			rebuildWorstHeap();
+			mEvaluationCount = 0;
+			mSuccessCount    = 0;
+			if( !completeSteadyStateGeneration( false ) ) { return; }
+		}
+		// Breed offspring:
+		for(size_t i = 0; i < mOffspringCount; i++) {
+			if( !breedOffspring( mOffspring[ i ], mOffspringParentScores[ i ], mOffspringRates[ i ], mOffspringScores[ i ] ) ) {
+				mOffspringScores[ i ] = mFitnessFunction( mOffspring[ i ], mGeneCount );
+			}
+		}
+		// Replace the worst members in place:
+		for(size_t i = 0; i < mOffspringCount && mRunning; i++) {
+			replaceWorst( mOffspring[ i ], mOffspringScores[ i ], mOffspringParentScores[ i ], mOffspringRates[ i ] );
+		}
+		// Advance generation iter once per population-size worth of evaluations:
+		mEvaluationCount += mOffspringCount;
+		if( mRunning && mEvaluationCount >= mPopulationSize ) {
+			mEvaluationCount -= mPopulationSize;
+			mGenerationIter++;
+			completeSteadyStateGeneration( true );
+		}
+	}
+	
+	/**
+	 * @brief Breeds a child from two tournament-selected members and mutates it. Returns true if the mutation
+	 * also provided the child's score.
+	 */
+	bool breedOffspring(DataType* oChild, float& oParentScore, float& oRate, float& oScore)
+	{
+		size_t tIdxA = selectByTournament();
+		size_t tIdxB = selectByTournament();
+		mCrossoverFunction( mPopulation[ tIdxA ], mPopulation[ tIdxB ], oChild, mGeneCount );
+		oParentScore = std::max( mScores[ tIdxA ], mScores[ tIdxB ] );
+		// Apply mutation at the child's own rate, if self-adaptive:
+		if( mMutationControl == MUTATION_SELF_ADAPTIVE && mIndividualRates.size() == mPopulationSize ) {
+			oRate = inheritMutationRate( mIndividualRates[ tIdxA ], mIndividualRates[ tIdxB ] );
+		}
+		else {
+			oRate = mMutationRate;
+		}
+		return mutateOffspring( oChild, oRate, oScore );
+	}
+	
+	/**
+	 * @brief Mutates a child at the given rate. Returns true if the scoring mutation function provided its score.
+	 */
+	bool mutateOffspring(DataType* ioChild, const float& iRate, float& oScore)
+	{
+		if( mScoringMutationFunction ) {
+			oScore = mScoringMutationFunction( ioChild, mGeneCount, iRate );
+			return true;
+		}
+		mMutationFunction( ioChild, mGeneCount, iRate );
+		return false;
+	}
+	
+	/**
+	 * @brief Runs one generation's worth of asynchronous evaluations. Whenever a worker returns a scored child,
+	 * the child is integrated into the population and a new child is bred in its task slot.
+	 */
+	void runAsyncStep()
+	{
+		if( !mFitnessFunction || !mCrossoverFunction || !( mMutationFunction || mScoringMutationFunction ) || !mPopulation ) { return; }
+		startWorkers();
+		EvaluationTask* tTask = NULL;
+		// Score the whole population once:
+		if( mScores.size() != mPopulationSize ) {
+			mScores.resize( mPopulationSize );
+			size_t tSubmitted = 0;
+			for(size_t tReceived = 0; tReceived < mPopulationSize; tReceived++) {
+				// Submit members while task slots are free:
+				while( tSubmitted < mPopulationSize && !mFreeTasks.empty() ) {
+					tTask = mFreeTasks.back();
+					mFreeTasks.pop_back();
+					std::copy( mPopulation[ tSubmitted ], mPopulation[ tSubmitted ] + mGeneCount, tTask->mGenes.begin() );
+					tTask->mTargetIdx = tSubmitted++;
+					mTaskQueue.push( tTask );
+				}
+				// Collect a score:
+				mResultQueue.pop( tTask );
+				mScores[ tTask->mTargetIdx ] = tTask->mScore;
+				mFreeTasks.push_back( tTask );
+			}
+			rebuildWorstHeap();
+			mEvaluationCount = 0;
+			mSuccessCount    = 0;
+			if( !completeSteadyStateGeneration( false ) ) {
+				stopWorkers();
+				return;
+			}
+		}
+		while( mRunning ) {
+			// Refill free task slots with new offspring (children already scored by the mutation skip the workers):
+			while( !mFreeTasks.empty() ) {
+				tTask = mFreeTasks.back();
+				mFreeTasks.pop_back();
+				tTask->mTargetIdx = mPopulationSize;
+				if( breedOffspring( tTask->mGenes.data(), tTask->mParentScore, tTask->mRate, tTask->mScore ) ) {
+					mResultQueue.push( tTask );
+				}
+				else {
+					mTaskQueue.push( tTask );
+				}
+			}
+			// Integrate the next completed evaluation:
+			mResultQueue.pop( tTask );
+			replaceWorst( tTask->mGenes.data(), tTask->mScore, tTask->mParentScore, tTask->mRate );
+			mFreeTasks.push_back( tTask );
+			// Advance generation iter once per population-size worth of evaluations:
+			if( ++mEvaluationCount >= mPopulationSize ) {
+				mEvaluationCount -= mPopulationSize;
+				mGenerationIter++;
+				completeSteadyStateGeneration( true );
+				break;
+			}
+		}
+		// Release the workers once the process has stopped:
+		if( !mRunning ) {
+			stopWorkers();
+		}
+	}
+	
+	/**
+	 * @brief Launches the evaluation workers, if not already running
+	 */
+	void startWorkers()
+	{
+		if( !mWorkers.empty() ) { return; }
+		mTaskQueue.reset( mTasks.size() );
+		mResultQueue.reset( mTasks.size() );
+		mFreeTasks.clear();
+		for(size_t i = 0; i < mTasks.size(); i++) {
+			mFreeTasks.push_back( &mTasks[ i ] );
+		}
+		for(size_t i = 0; i < mWorkerCount; i++) {
+			mWorkers.push_back( std::thread( [this]() {
+				EvaluationTask* tTask = NULL;
+				while( mTaskQueue.pop( tTask ) ) {
+					tTask->mScore = mFitnessFunction( tTask->mGenes.data(), mGeneCount );
+					mResultQueue.push( tTask );
+				}
+			} ) );
+		}
+	}
+	
+	/**
+	 * @brief Stops and joins the evaluation workers, discarding any evaluations still in flight
+	 */
+	void stopWorkers()
+	{
+		mTaskQueue.close();
+		mResultQueue.close();
+		for(size_t i = 0; i < mWorkers.size(); i++) {
+			mWorkers[ i ].join();
+		}
+		mWorkers.clear();
+	}
+	
+	/**
+	 * @brief Copies the given child over the current worst member if the child scores at least as well
+	 */
+	void replaceWorst(const DataType* iChild, const float& iScore, const float& iParentScore, const float& iRate)
+	{
+		if( iScore > iParentScore ) {
+			mSuccessCount++;
+		}
+		// Pop the worst member:
+		std::pop_heap( mWorstHeap.begin(), mWorstHeap.end(), std::greater<ScoreIndex>() );
+		ScoreIndex& tWorst = mWorstHeap.back();
+		if( iScore >= tWorst.first ) {
+			size_t tIdx = tWorst.second;
+			// Overwrite the member's genes and score:
+			std::copy( iChild, iChild + mGeneCount, mPopulation[ tIdx ] );
+			mScores[ tIdx ] = iScore;
+			tWorst.first    = iScore;
+			if( mIndividualRates.size() == mPopulationSize ) {
+				mIndividualRates[ tIdx ] = iRate;
+			}
+			// Track the best member:
+			if( tIdx == mBestIdx ) {
+				mBestIdx = std::max_element( mScores.begin(), mScores.end() ) - mScores.begin();
+			}
+			else if( iScore > mScores[ mBestIdx ] ) {
+				mBestIdx = tIdx;
+				checkWinState( tIdx );
+			}
+		}
+		// Push the (possibly replaced) member back:
+		std::push_heap( mWorstHeap.begin(), mWorstHeap.end(), std::greater<ScoreIndex>() );
+	}
+	
+	/**
+	 * @brief Rebuilds the min-heap of member scores
+	 */
+	void rebuildWorstHeap()
+	{
+		mWorstHeap.resize( mPopulationSize );
+		for(size_t i = 0; i < mPopulationSize; i++) {
+			mWorstHeap[ i ] = ScoreIndex( mScores[ i ], i );
+		}
+		std::make_heap( mWorstHeap.begin(), mWorstHeap.end(), std::greater<ScoreIndex>() );
+		mBestIdx = std::max_element( mScores.begin(), mScores.end() ) - mScores.begin();
+	}
+	
+	/**
+	 * @brief Returns the index of the better of two randomly chosen members
+	 */
+	size_t selectByTournament() const
+	{
+		size_t tIdxA = randomInt( 0, (int)mPopulationSize );
+		size_t tIdxB = randomInt( 0, (int)mPopulationSize );
+		return ( mScores[ tIdxA ] >= mScores[ tIdxB ] ) ? tIdxA : tIdxB;
+	}
+	
+	/**
+	 * @brief Applies the generation bookkeeping to the steady-state population, including immigration if stagnant.
+	 * Returns false if the evolutionary process should stop.
+	 */
+	bool completeSteadyStateGeneration(const bool& iHasOffspring)
+	{
+		// Gather score statistics:
+		float tScoreSum   = 0.0;
+		float tScoreSqSum = 0.0;
+		for(size_t i = 0; i < mPopulationSize; i++) {
+			tScoreSum   += mScores[ i ];
+			tScoreSqSum += mScores[ i ] * mScores[ i ];
+		}
+		float tSuccessRatio = iHasOffspring ? ( (float)mSuccessCount / (float)mPopulationSize ) : -1.0f;
+		mSuccessCount = 0;
+		if( !completeGeneration( mBestIdx, mScores[ mBestIdx ], tScoreSum, tScoreSqSum, tSuccessRatio ) ) {
+			return false;
+		}
+		// Replace a portion of the population with immigrants, if stagnant:
+		if( mStagnated && mStagnationAction == STAGNATION_IMMIGRANTS && mInitializeFunction ) {
+			size_t tCount = std::min( (size_t)( mStagnationParam * mPopulationSize ), mPopulationSize );
+			for(size_t i = 0; i < tCount; i++) {
+				size_t tIdx = randomInt( 0, (int)mPopulationSize );
+				mInitializeFunction( mPopulation[ tIdx ], mGeneCount );
+				mScores[ tIdx ] = mFitnessFunction( mPopulation[ tIdx ], mGeneCount );
+			}
+			rebuildWorstHeap();
+		}
+		return true;
+	}
+	
+	/**
+	 * @brief Rebuilds the per-locus allele histograms in O(N*L) and derives the diversity metrics from them.
+	 * The mean pairwise Hamming distance follows from the histograms without comparing individuals:
+	 * at each locus, the number of differing ordered pairs is N^2 minus the sum of the squared allele counts.
+	 */
+	void updateDiversity()
+	{
+		if( mAlleleCount == 0 || !mPopulation ) { return; }
+		// Clear histograms:
+		std::fill( mAlleleHistogram.begin(), mAlleleHistogram.end(), 0 );
+		// Count alleles (the histogram is stored locus-major, so each individual is scanned in order):
+		for(size_t i = 0; i < mPopulationSize; i++) {
+			const DataType* tGenes = mPopulation[ i ];
+			size_t* tCounts = &mAlleleHistogram[ 0 ];
+			for(size_t j = 0; j < mGeneCount; j++, tCounts += mAlleleCount) {
+				int tIdx = (int)tGenes[ j ] - mAlleleMin;
+				if( tIdx >= 0 && tIdx < mAlleleCount ) {
+					tCounts[ tIdx ]++;
+				}
+			}
+		}
+		// Compute entropy and pairwise distance per locus:
+		float tN        = (float)mPopulationSize;
+		float tLogK     = ( mAlleleCount > 1 ) ? std::log( (float)mAlleleCount ) : 1.0f;
+		float tEntropy  = 0.0f;
+		float tDistance = 0.0f;
+		for(size_t j = 0; j < mGeneCount; j++) {
+			const size_t* tCounts = &mAlleleHistogram[ j * mAlleleCount ];
+			float tLocusEntropy = 0.0f;
+			float tSqSum = 0.0f;
+			for(int k = 0; k < mAlleleCount; k++) {
+				if( tCounts[ k ] > 0 ) {
+					float tP = (float)tCounts[ k ] / tN;
+					tLocusEntropy -= tP * std::log( tP );
+					tSqSum += (float)tCounts[ k ] * (float)tCounts[ k ];
+				}
+			}
+			mLocusEntropy[ j ] = tLocusEntropy / tLogK;
+			tEntropy  += mLocusEntropy[ j ];
+			tDistance += ( tN * tN - tSqSum );
+		}
+		mMeanEntropy  = tEntropy / (float)mGeneCount;
+		mMeanDistance = ( mPopulationSize > 1 ) ? ( tDistance / ( tN * ( tN - 1.0f ) * (float)mGeneCount ) ) : 0.0f;
+	}
+	
+	/**
+	 * @brief Updates the population-wide mutation rate according to the active controller. The success ratio is
+	 * the fraction of recent children that outscored their best parent, or negative if unknown.
+	 */
+	void updateMutationRate(const float& iSuccessRatio)
+	{
+		switch( mMutationControl ) {
+			case MUTATION_ONE_FIFTH : {
+				if( iSuccessRatio < 0.0f ) { break; }
+				// Apply the 1/5th success rule:
+				float tFactor = ( iSuccessRatio > 0.2f ) ? ( 1.0f / 0.82f ) : ( 0.82f );
+				mMutationRate = std::min( std::max( mMutationRate * tFactor, mMutationRateMin ), mMutationRateMax );
+				break;
+			}
+			case MUTATION_DIVERSITY : {
+				if( mAlleleCount == 0 ) { break; }
+				mMutationRate = mMutationRateMin + ( mMutationRateMax - mMutationRateMin ) * ( 1.0f - mMeanEntropy );
+				break;
+			}
+			case MUTATION_SELF_ADAPTIVE : {
+				// Report the mean individual rate:
+				float tSum = 0.0f;
+				for(size_t i = 0; i < mIndividualRates.size(); i++) {
+					tSum += mIndividualRates[ i ];
+				}
+				if( !mIndividualRates.empty() ) {
+					mMutationRate = tSum / (float)mIndividualRates.size();
+				}
+				break;
+			}
+			default : { break; }
+		}
+	}
+	
+	/**
+	 * @brief Returns a child's mutation rate: the geometric mean of its parents' rates, perturbed log-normally
+	 */
+	float inheritMutationRate(const float& iRateA, const float& iRateB) const
+	{
+		float tTau  = 1.0f / std::sqrt( (float)mGeneCount );
+		float tRate = std::sqrt( iRateA * iRateB ) * std::exp( tTau * randomGaussian() );
+		return std::min( std::max( tRate, mMutationRateMin ), mMutationRateMax );
+	}
+	
+	/**
+	 * @brief Updates the stagnation state from the current generation's score statistics and applies
+	 * any rate changes. Returns true if the population is stagnant.
+	 */
+	bool updateStagnation(const float& iBestScore, const float& iScoreSum, const float& iScoreSqSum)
+	{
+		mStagnated = false;
+		if( mStagnationWindow == 0 ) { return false; }
+		// Compute score statistics:
+		float tAvgScore = iScoreSum / (float)mPopulationSize;
+		float tVariance = std::max( iScoreSqSum / (float)mPopulationSize - tAvgScore * tAvgScore, 0.0f );
+		// Check for improvement over the best and average records:
+		bool tImproved = false;
+		if( iBestScore > mBestScoreRecord + mStagnationEpsilon ) {
+			mBestScoreRecord = iBestScore;
+			tImproved = true;
+		}
+		if( tAvgScore > mAvgScoreRecord + mStagnationEpsilon ) {
+			mAvgScoreRecord = tAvgScore;
+			tImproved = true;
+		}
+		// Update stagnant generation count:
+		if( tImproved ) {
+			mStagnantGenerations = 0;
+			if( mMutationControl == MUTATION_FIXED ) {
+				mMutationRate = mMutationRateBase;
+			}
+		}
+		else {
+			mStagnantGenerations++;
+		}
+		// Check for stagnation or diversity collapse:
+		if( mStagnantGenerations >= mStagnationWindow || std::sqrt( tVariance ) < mDiversityThreshold ) {
+			mStagnated = true;
+			mStagnantGenerations = 0;
+			// Raise mutation rate, if applicable:
+			if( mStagnationAction == STAGNATION_MUTATION ) {
+				mMutationRate = std::min( mMutationRate * mStagnationParam, 1.0f );
+			}
+		}
+		return mStagnated;
+	}
 };
\ No newline at end of file
@@ -27,7 +27,7 @@ static float fitnessFunc(const int* iBoard, const size_t& iTileCount)
 {
 	// EXERCISE: Please implement a function that evaluates the fitness of a given sudoku board...
 	
-	return (float)rand() / (float)RAND_MAX;
+	return randomUnit();
 }
 
 static void crossoverFunc(const int* iBoardA, const int* iBoardB, int* oBoard, const size_t& iTileCount)
@@ -46,7 +46,7 @@ static void mutateFunc(int* ioBoard, const size_t& iTileCount, const float& iMut
 	// EXERCISE: Please feel free to replace the contents of this function to improve upon your algorithm's performance...
 	
 	for(int i = 0; i < iTileCount; i++) {
-		if( ( (float)rand() / (float)RAND_MAX ) < iMutationRate ) {
+		if( randomUnit() < iMutationRate ) {
 			ioBoard[i] = randomInt( getTileValueMin(), getTileValueMax() + 1 );
 		}
 	}
@@ -0,0 +1,310 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Returns the number of set bits in the input mask
+ */
+inline int popCount(const uint32_t& iMask)
+{
+	return __builtin_popcount( iMask );
+}
+
+/**
+ * @brief A Sudoku constraint engine that represents each row, column and box as a bitmask of the digits it contains.
+ * A unit that is missing k digits must hold k duplicates, so a board's conflict count is the total number of digits
+ * missing from its units. Supports boards with up to 25 digits per axis.
+ */
+class SudokuConstraints {
+protected:
+	size_t					mTileCount;
+	size_t					mAxis;
+	size_t					mBoxAxis;
+	int						mValueMin;
+	std::vector<size_t>		mBoxIndex;
+
+public:
+
+	/**
+	 * @brief SudokuConstraints constructor for a square board of iTileCount tiles with values starting at iValueMin
+	 */
+	SudokuConstraints(const size_t& iTileCount = 81, const int& iValueMin = 1) :
+		mTileCount( iTileCount ),
+		mAxis( (size_t)( std::sqrt( (float)iTileCount ) + 0.5f ) ),
+		mValueMin( iValueMin )
+	{
+		mBoxAxis = (size_t)( std::sqrt( (float)mAxis ) + 0.5f );
+		// Precompute the box index of each tile:
+		mBoxIndex.resize( mTileCount );
+		for(size_t i = 0; i < mTileCount; i++) {
+			size_t tRow = i / mAxis;
+			size_t tCol = i % mAxis;
+			mBoxIndex[ i ] = ( tRow / mBoxAxis ) * mBoxAxis + ( tCol / mBoxAxis );
+		}
+	}
+
+	/**
+	 * @brief Returns the number of digits missing from the board's rows, columns and boxes (0 for a solved board)
+	 */
+	size_t getConflictCount(const int* iBoard) const
+	{
+		// Build unit masks:
+		uint32_t tRows[ 32 ] = { 0 };
+		uint32_t tCols[ 32 ] = { 0 };
+		uint32_t tBoxes[ 32 ] = { 0 };
+		for(size_t i = 0; i < mTileCount; i++) {
+			uint32_t tBit = getValueBit( iBoard[ i ] );
+			tRows[ i / mAxis ]       |= tBit;
+			tCols[ i % mAxis ]       |= tBit;
+			tBoxes[ mBoxIndex[ i ] ] |= tBit;
+		}
+		// Count missing digits:
+		size_t tConflicts = 0;
+		for(size_t i = 0; i < mAxis; i++) {
+			tConflicts += 3 * mAxis - popCount( tRows[ i ] ) - popCount( tCols[ i ] ) - popCount( tBoxes[ i ] );
+		}
+		return tConflicts;
+	}
+
+	/**
+	 * @brief Returns whether the board represents a Sudoku win state
+	 */
+	bool getBoardWin(const int* iBoard) const
+	{
+		return ( getConflictCount( iBoard ) == 0 );
+	}
+
+	/**
+	 * @brief Returns a fitness score between 0 (every unit holds a single digit) and 1 (a solved board)
+	 */
+	float getFitness(const int* iBoard) const
+	{
+		return 1.0f - (float)getConflictCount( iBoard ) / (float)getConflictMax();
+	}
+
+	/**
+	 * @brief Returns the highest possible conflict count
+	 */
+	size_t getConflictMax() const
+	{
+		return 3 * mAxis * ( mAxis - 1 );
+	}
+
+	/**
+	 * @brief Returns the mask bit of the given tile value, or zero if the value is out of range
+	 */
+	uint32_t getValueBit(const int& iValue) const
+	{
+		int tOffset = iValue - mValueMin;
+		return ( tOffset >= 0 && tOffset < (int)mAxis ) ? ( 1u << tOffset ) : 0;
+	}
+
+	/**
+	 * @brief Returns the minimum tile value
+	 */
+	const int& getValueMin() const
+	{
+		return mValueMin;
+	}
+
+	/**
+	 * @brief Returns the number of tiles on each axis
+	 */
+	const size_t& getAxis() const
+	{
+		return mAxis;
+	}
+
+	/**
+	 * @brief Returns the number of tiles on each box axis
+	 */
+	const size_t& getBoxAxis() const
+	{
+		return mBoxAxis;
+	}
+
+	/**
+	 * @brief Returns the box index of the given tile
+	 */
+	const size_t& getBoxIndex(const size_t& iTile) const
+	{
+		return mBoxIndex[ iTile ];
+	}
+};
+
+/**
+ * @brief A mutable Sudoku board that keeps per-unit digit counters, so that its conflict count is updated in O(1)
+ * whenever a tile changes. The conflict count matches SudokuConstraints::getConflictCount().
+ */
+class SudokuBoardState {
+protected:
+	const SudokuConstraints*	mConstraints;
+	std::vector<int>			mTiles;
+	std::vector<int>			mRowCounts;
+	std::vector<int>			mColCounts;
+	std::vector<int>			mBoxCounts;
+	size_t						mConflicts;
+
+public:
+
+	/**
+	 * @brief SudokuBoardState constructor. The constraints must outlive the board state.
+	 */
+	SudokuBoardState(const SudokuConstraints& iConstraints) :
+		mConstraints( &iConstraints ),
+		mConflicts( 0 )
+	{
+	}
+
+	/**
+	 * @brief Copies the input board and rebuilds all counters
+	 */
+	void load(const int* iBoard)
+	{
+		size_t tAxis      = mConstraints->getAxis();
+		size_t tTileCount = tAxis * tAxis;
+		mTiles.assign( iBoard, iBoard + tTileCount );
+		mRowCounts.assign( tTileCount, 0 );
+		mColCounts.assign( tTileCount, 0 );
+		mBoxCounts.assign( tTileCount, 0 );
+		// Count digits per unit:
+		for(size_t i = 0; i < tTileCount; i++) {
+			int tDigit = getDigit( mTiles[ i ] );
+			if( tDigit < 0 ) { continue; }
+			mRowCounts[ ( i / tAxis ) * tAxis + tDigit ]++;
+			mColCounts[ ( i % tAxis ) * tAxis + tDigit ]++;
+			mBoxCounts[ mConstraints->getBoxIndex( i ) * tAxis + tDigit ]++;
+		}
+		// Count missing digits:
+		mConflicts = 0;
+		for(size_t i = 0; i < tTileCount; i++) {
+			mConflicts += ( mRowCounts[ i ] == 0 ) + ( mColCounts[ i ] == 0 ) + ( mBoxCounts[ i ] == 0 );
+		}
+	}
+
+	/**
+	 * @brief Brings the state to the input board by setting only the tiles that differ from the current board,
+	 * so its cost is one comparison per tile plus a constant-time update per changed tile. Loads the board in full
+	 * if the state is empty.
+	 */
+	void update(const int* iBoard)
+	{
+		if( mTiles.empty() ) {
+			load( iBoard );
+			return;
+		}
+		for(size_t i = 0; i < mTiles.size(); i++) {
+			if( mTiles[ i ] != iBoard[ i ] ) {
+				setTile( i, iBoard[ i ] );
+			}
+		}
+	}
+
+	/**
+	 * @brief Sets the given tile's value, updating the conflict count in constant time
+	 */
+	void setTile(const size_t& iTile, const int& iValue)
+	{
+		size_t tAxis = mConstraints->getAxis();
+		size_t tRow  = ( iTile / tAxis ) * tAxis;
+		size_t tCol  = ( iTile % tAxis ) * tAxis;
+		size_t tBox  = mConstraints->getBoxIndex( iTile ) * tAxis;
+		// Remove previous value:
+		int tDigit = getDigit( mTiles[ iTile ] );
+		if( tDigit >= 0 ) {
+			mConflicts += ( --mRowCounts[ tRow + tDigit ] == 0 ) + ( --mColCounts[ tCol + tDigit ] == 0 ) + ( --mBoxCounts[ tBox + tDigit ] == 0 );
+		}
+		// Add new value:
+		tDigit = getDigit( iValue );
+		if( tDigit >= 0 ) {
+			mConflicts -= ( mRowCounts[ tRow + tDigit ]++ == 0 ) + ( mColCounts[ tCol + tDigit ]++ == 0 ) + ( mBoxCounts[ tBox + tDigit ]++ == 0 );
+		}
+		mTiles[ iTile ] = iValue;
+	}
+
+	/**
+	 * @brief Exchanges the values of two tiles
+	 */
+	void swapTiles(const size_t& iTileA, const size_t& iTileB)
+	{
+		int tValueA = mTiles[ iTileA ];
+		setTile( iTileA, mTiles[ iTileB ] );
+		setTile( iTileB, tValueA );
+	}
+
+	/**
+	 * @brief Returns the number of copies of the given value in the tile's row, column and box, excluding the tile itself
+	 */
+	int getClashCount(const size_t& iTile, const int& iValue) const
+	{
+		int tDigit = getDigit( iValue );
+		if( tDigit < 0 ) { return 0; }
+		size_t tAxis = mConstraints->getAxis();
+		int tSelf    = ( mTiles[ iTile ] == iValue ) ? 1 : 0;
+		return ( mRowCounts[ ( iTile / tAxis ) * tAxis + tDigit ] - tSelf ) +
+			   ( mColCounts[ ( iTile % tAxis ) * tAxis + tDigit ] - tSelf ) +
+			   ( mBoxCounts[ mConstraints->getBoxIndex( iTile ) * tAxis + tDigit ] - tSelf );
+	}
+
+	/**
+	 * @brief Returns the current conflict count
+	 */
+	const size_t& getConflictCount() const
+	{
+		return mConflicts;
+	}
+
+	/**
+	 * @brief Returns whether the board represents a Sudoku win state
+	 */
+	bool getBoardWin() const
+	{
+		return ( mConflicts == 0 );
+	}
+
+	/**
+	 * @brief Returns a fitness score between 0 and 1, matching SudokuConstraints::getFitness()
+	 */
+	float getFitness() const
+	{
+		return 1.0f - (float)mConflicts / (float)mConstraints->getConflictMax();
+	}
+
+	/**
+	 * @brief Returns the value of the given tile
+	 */
+	const int& getTile(const size_t& iTile) const
+	{
+		return mTiles[ iTile ];
+	}
+
+	/**
+	 * @brief Copies the board's tiles into the output board
+	 */
+	void store(int* oBoard) const
+	{
+		std::copy( mTiles.begin(), mTiles.end(), oBoard );
+	}
+
+protected:
+
+	/**
+	 * @brief Returns the zero-based digit of the given value, or -1 if the value is out of range
+	 */
+	int getDigit(const int& iValue) const
+	{
+		int tOffset = iValue - mConstraints->getValueMin();
+		return ( tOffset >= 0 && tOffset < (int)mConstraints->getAxis() ) ? tOffset : -1;
+	}
+};
@@ -0,0 +1,298 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Population.h"
+#include "SudokuConstraints.h"
+
+/**
+ * @brief A permutation encoding for Sudoku boards. Each row holds its givens in place and a permutation of its
+ * missing digits in the remaining tiles, so every row is always valid and the search only has to satisfy the column
+ * and box constraints. Mutation swaps free tiles within a row and crossover exchanges whole rows, which preserves the
+ * encoding.
+ *
+ * With a repair budget, the genome becomes a hybrid solver: naked singles implied by the givens are filled in once,
+ * and each mutated child is then improved by up to that many min-conflicts swaps before it is scored.
+ */
+class SudokuGenome {
+protected:
+	const SudokuConstraints*			mConstraints;
+	std::vector<int>					mGivens;
+	std::vector< std::vector<size_t> >	mFreeTiles;
+	std::vector< std::vector<int> >		mMissingValues;
+	std::vector<size_t>					mRepairTiles;
+	size_t								mRepairBudget;
+
+public:
+
+	/**
+	 * @brief SudokuGenome constructor. Givens use zero for empty tiles; a NULL puzzle leaves every tile free.
+	 * The constraints must outlive the genome.
+	 */
+	SudokuGenome(const SudokuConstraints& iConstraints, const int* iGivens = NULL) :
+		mConstraints( &iConstraints ),
+		mRepairBudget( 0 )
+	{
+		size_t tAxis = mConstraints->getAxis();
+		mGivens.assign( tAxis * tAxis, 0 );
+		if( iGivens ) {
+			mGivens.assign( iGivens, iGivens + tAxis * tAxis );
+		}
+		updateFreeTiles();
+	}
+
+	/**
+	 * @brief Sets the number of min-conflicts repair moves applied to each mutated child (0 disables repair).
+	 * Enabling repair also fills in the naked singles implied by the givens.
+	 */
+	void setRepairBudget(const size_t& iBudget)
+	{
+		mRepairBudget = iBudget;
+		if( mRepairBudget > 0 && propagateSingles() ) {
+			updateFreeTiles();
+		}
+	}
+
+	/**
+	 * @brief Returns the repair budget
+	 */
+	const size_t& getRepairBudget() const
+	{
+		return mRepairBudget;
+	}
+
+	/**
+	 * @brief Returns whether the given tile holds a given value
+	 */
+	bool isGiven(const size_t& iTile) const
+	{
+		return ( mConstraints->getValueBit( mGivens[ iTile ] ) != 0 );
+	}
+
+	/**
+	 * @brief Fills each row with its givens and a random permutation of its missing values
+	 */
+	void initialize(int* oBoard, const size_t& iTileCount) const
+	{
+		for(size_t tRow = 0; tRow < mFreeTiles.size(); tRow++) {
+			const std::vector<size_t>& tFree   = mFreeTiles[ tRow ];
+			const std::vector<int>&    tValues = mMissingValues[ tRow ];
+			size_t tAxis = mConstraints->getAxis();
+			for(size_t tCol = 0; tCol < tAxis; tCol++) {
+				oBoard[ tRow * tAxis + tCol ] = mGivens[ tRow * tAxis + tCol ];
+			}
+			// Fisher-Yates shuffle into the free tiles:
+			for(size_t i = 0; i < tFree.size(); i++) {
+				oBoard[ tFree[ i ] ] = tValues[ i ];
+			}
+			for(size_t i = tFree.size(); i > 1; i--) {
+				size_t j = randomInt( 0, (int)i );
+				std::swap( oBoard[ tFree[ i - 1 ] ], oBoard[ tFree[ j ] ] );
+			}
+		}
+	}
+
+	/**
+	 * @brief Builds a child by taking each row whole from one parent or the other
+	 */
+	void crossover(const int* iBoardA, const int* iBoardB, int* oBoard, const size_t& iTileCount) const
+	{
+		size_t tAxis = mConstraints->getAxis();
+		for(size_t tRow = 0; tRow < tAxis; tRow++) {
+			const int* tSource = ( randomNext() & 1 ) ? iBoardA : iBoardB;
+			std::copy( tSource + tRow * tAxis, tSource + ( tRow + 1 ) * tAxis, oBoard + tRow * tAxis );
+		}
+	}
+
+	/**
+	 * @brief Swaps each free tile, at the given rate, with another free tile in the same row
+	 */
+	void mutate(int* ioBoard, const size_t& iTileCount, const float& iMutationRate) const
+	{
+		for(size_t tRow = 0; tRow < mFreeTiles.size(); tRow++) {
+			const std::vector<size_t>& tFree = mFreeTiles[ tRow ];
+			if( tFree.size() < 2 ) { continue; }
+			for(size_t i = 0; i < tFree.size(); i++) {
+				if( randomUnit() < iMutationRate ) {
+					std::swap( ioBoard[ tFree[ i ] ], ioBoard[ tFree[ randomInt( 0, (int)tFree.size() ) ] ] );
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Applies the same swaps as mutate() while rescoring the board incrementally, and returns its fitness.
+	 * The state carries over from the previous child, so only the tiles in which this child differs from it
+	 * (such as the rows taken from a different parent) are rescored before the swaps.
+	 */
+	float mutateScored(int* ioBoard, const size_t& iTileCount, const float& iMutationRate, SudokuBoardState& ioState) const
+	{
+		ioState.update( ioBoard );
+		for(size_t tRow = 0; tRow < mFreeTiles.size(); tRow++) {
+			const std::vector<size_t>& tFree = mFreeTiles[ tRow ];
+			if( tFree.size() < 2 ) { continue; }
+			for(size_t i = 0; i < tFree.size(); i++) {
+				if( randomUnit() < iMutationRate ) {
+					size_t tTileA = tFree[ i ];
+					size_t tTileB = tFree[ randomInt( 0, (int)tFree.size() ) ];
+					ioState.swapTiles( tTileA, tTileB );
+					std::swap( ioBoard[ tTileA ], ioBoard[ tTileB ] );
+				}
+			}
+		}
+		repair( ioBoard, ioState );
+		return ioState.getFitness();
+	}
+
+	/**
+	 * @brief Applies up to the repair budget of min-conflicts moves: each move picks a random free tile and, if it
+	 * clashes, swaps it with the free tile in its row that leaves the fewest conflicts, unless that would add conflicts.
+	 * The state must hold the board on entry.
+	 */
+	void repair(int* ioBoard, SudokuBoardState& ioState) const
+	{
+		if( mRepairTiles.empty() ) { return; }
+		size_t tAxis = mConstraints->getAxis();
+		for(size_t tMove = 0; tMove < mRepairBudget && !ioState.getBoardWin(); tMove++) {
+			size_t tTile = mRepairTiles[ randomInt( 0, (int)mRepairTiles.size() ) ];
+			if( ioState.getClashCount( tTile, ioState.getTile( tTile ) ) == 0 ) { continue; }
+			// Find the best swap partner within the row:
+			const std::vector<size_t>& tFree = mFreeTiles[ tTile / tAxis ];
+			size_t tBestConflicts = ioState.getConflictCount();
+			size_t tBestPartner   = tTile;
+			for(size_t i = 0; i < tFree.size(); i++) {
+				if( tFree[ i ] == tTile ) { continue; }
+				ioState.swapTiles( tTile, tFree[ i ] );
+				// Accept sideways moves at random to escape plateaus:
+				if( ioState.getConflictCount() < tBestConflicts || ( ioState.getConflictCount() == tBestConflicts && ( randomNext() & 1 ) ) ) {
+					tBestConflicts = ioState.getConflictCount();
+					tBestPartner   = tFree[ i ];
+				}
+				ioState.swapTiles( tTile, tFree[ i ] );
+			}
+			// Apply the best swap:
+			if( tBestPartner != tTile ) {
+				ioState.swapTiles( tTile, tBestPartner );
+				std::swap( ioBoard[ tTile ], ioBoard[ tBestPartner ] );
+			}
+		}
+	}
+
+	/**
+	 * @brief Returns the board's fitness (rows never conflict, so only columns and boxes contribute)
+	 */
+	float fitness(const int* iBoard, const size_t& iTileCount) const
+	{
+		return mConstraints->getFitness( iBoard );
+	}
+
+	/**
+	 * @brief Binds the genome's operators, fitness and win check to the given population. The genome must outlive it.
+	 */
+	void bind(Population<int>& ioPopulation) const
+	{
+		// Each binding owns a board state for incremental rescoring:
+		std::shared_ptr<SudokuBoardState> tState( new SudokuBoardState( *mConstraints ) );
+		const SudokuGenome* tGenome = this;
+		ioPopulation.setInitializeFunction( [tGenome](int* oBoard, const size_t& iTileCount) {
+			tGenome->initialize( oBoard, iTileCount );
+		} );
+		ioPopulation.setFitnessFunction( [tGenome](const int* iBoard, const size_t& iTileCount) {
+			return tGenome->fitness( iBoard, iTileCount );
+		} );
+		ioPopulation.setCrossoverFunction( [tGenome](const int* iBoardA, const int* iBoardB, int* oBoard, const size_t& iTileCount) {
+			tGenome->crossover( iBoardA, iBoardB, oBoard, iTileCount );
+		} );
+		ioPopulation.setScoringMutationFunction( [tGenome, tState](int* ioBoard, const size_t& iTileCount, const float& iMutationRate) {
+			return tGenome->mutateScored( ioBoard, iTileCount, iMutationRate, *tState );
+		} );
+		ioPopulation.setWinFunction( [tGenome](const int* iBoard, const size_t& iTileCount) {
+			return tGenome->mConstraints->getBoardWin( iBoard );
+		} );
+	}
+
+protected:
+
+	/**
+	 * @brief Rebuilds the free tiles and missing values of each row from the givens
+	 */
+	void updateFreeTiles()
+	{
+		size_t tAxis = mConstraints->getAxis();
+		mFreeTiles.assign( tAxis, std::vector<size_t>() );
+		mMissingValues.assign( tAxis, std::vector<int>() );
+		mRepairTiles.clear();
+		// Find the free tiles and missing values of each row:
+		for(size_t tRow = 0; tRow < tAxis; tRow++) {
+			std::vector<bool> tPresent( tAxis, false );
+			for(size_t tCol = 0; tCol < tAxis; tCol++) {
+				size_t tTile = tRow * tAxis + tCol;
+				if( isGiven( tTile ) ) {
+					tPresent[ mGivens[ tTile ] - mConstraints->getValueMin() ] = true;
+				}
+				else {
+					mFreeTiles[ tRow ].push_back( tTile );
+				}
+			}
+			for(size_t i = 0; i < tAxis; i++) {
+				if( !tPresent[ i ] ) {
+					mMissingValues[ tRow ].push_back( mConstraints->getValueMin() + (int)i );
+				}
+			}
+			// Pad rows whose givens repeat a digit:
+			mMissingValues[ tRow ].resize( mFreeTiles[ tRow ].size(), mConstraints->getValueMin() );
+			// Only rows with two or more free tiles can be repaired:
+			if( mFreeTiles[ tRow ].size() > 1 ) {
+				mRepairTiles.insert( mRepairTiles.end(), mFreeTiles[ tRow ].begin(), mFreeTiles[ tRow ].end() );
+			}
+		}
+	}
+
+	/**
+	 * @brief Repeatedly fills in free tiles whose row, column and box givens leave a single candidate.
+	 * Returns true if any tile was filled.
+	 */
+	bool propagateSingles()
+	{
+		size_t tAxis      = mConstraints->getAxis();
+		size_t tTileCount = tAxis * tAxis;
+		uint32_t tFull    = ( 1u << tAxis ) - 1;
+		std::vector<uint32_t> tRows( tAxis, 0 );
+		std::vector<uint32_t> tCols( tAxis, 0 );
+		std::vector<uint32_t> tBoxes( tAxis, 0 );
+		// Build unit masks:
+		for(size_t i = 0; i < tTileCount; i++) {
+			uint32_t tBit = mConstraints->getValueBit( mGivens[ i ] );
+			tRows[ i / tAxis ]                       |= tBit;
+			tCols[ i % tAxis ]                       |= tBit;
+			tBoxes[ mConstraints->getBoxIndex( i ) ] |= tBit;
+		}
+		// Fill naked singles until none remain:
+		bool tFilled  = false;
+		bool tChanged = true;
+		while( tChanged ) {
+			tChanged = false;
+			for(size_t i = 0; i < tTileCount; i++) {
+				if( isGiven( i ) ) { continue; }
+				size_t   tBox        = mConstraints->getBoxIndex( i );
+				uint32_t tCandidates = tFull & ~( tRows[ i / tAxis ] | tCols[ i % tAxis ] | tBoxes[ tBox ] );
+				if( popCount( tCandidates ) != 1 ) { continue; }
+				mGivens[ i ] = mConstraints->getValueMin() + __builtin_ctz( tCandidates );
+				tRows[ i / tAxis ] |= tCandidates;
+				tCols[ i % tAxis ] |= tCandidates;
+				tBoxes[ tBox ]     |= tCandidates;
+				tChanged = tFilled = true;
+			}
+		}
+		return tFilled;
+	}
+};
@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A Sudoku puzzle: a square board of givens, where zero marks an empty tile
+ */
+struct SudokuPuzzle {
+	std::string			mName;
+	size_t				mAxis;
+	std::vector<int>	mGivens;
+
+	/**
+	 * @brief SudokuPuzzle constructor for an empty board
+	 */
+	SudokuPuzzle(const std::string& iName = "blank", const size_t& iAxis = 9) :
+		mName( iName ),
+		mAxis( iAxis ),
+		mGivens( iAxis * iAxis, 0 )
+	{
+	}
+
+	/**
+	 * @brief Returns the puzzle's tile count
+	 */
+	size_t getTileCount() const
+	{
+		return mGivens.size();
+	}
+
+	/**
+	 * @brief Returns the number of given tiles
+	 */
+	size_t getGivenCount() const
+	{
+		size_t tCount = 0;
+		for(size_t i = 0; i < mGivens.size(); i++) {
+			tCount += ( mGivens[ i ] > 0 );
+		}
+		return tCount;
+	}
+
+	/**
+	 * @brief Copies the givens over the corresponding tiles of the input board
+	 */
+	void applyGivens(int* ioBoard) const
+	{
+		for(size_t i = 0; i < mGivens.size(); i++) {
+			if( mGivens[ i ] > 0 ) {
+				ioBoard[ i ] = mGivens[ i ];
+			}
+		}
+	}
+};
+
+/**
+ * @brief Returns the board axis for the given tile count (9, 16 or 25), or zero if the count is unsupported
+ */
+inline size_t getPuzzleAxis(const size_t& iTileCount)
+{
+	for(size_t tBox = 3; tBox <= 5; tBox++) {
+		if( iTileCount == tBox * tBox * tBox * tBox ) {
+			return tBox * tBox;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Appends the puzzles in the given file to the output list and returns false if the file cannot be read
+ * or holds a malformed puzzle. A file may contain compact 9x9 puzzles, one 81-character line each ('.' or '0'
+ * for empty tiles), and whitespace-separated grids of 81, 256 or 625 values separated by blank lines.
+ * Lines beginning with '#' are ignored.
+ */
+inline bool loadPuzzles(const std::string& iPath, std::vector<SudokuPuzzle>& oPuzzles)
+{
+	std::ifstream tFile( iPath.c_str() );
+	if( !tFile.is_open() ) {
+		printf( "ERROR: Cannot open puzzle file \'%s\'.\n", iPath.c_str() );
+		return false;
+	}
+	std::vector<int> tValues;
+	std::string      tLine;
+	size_t           tLineIter = 0;
+	size_t           tFirst    = oPuzzles.size();
+	bool             tSuccess  = true;
+	// Finalizes the grid gathered so far:
+	auto tFlush = [&]() {
+		if( tValues.empty() ) { return; }
+		size_t tAxis = getPuzzleAxis( tValues.size() );
+		if( tAxis == 0 ) {
+			printf( "ERROR: Puzzle ending at \'%s\':%zu has %zu values.\n", iPath.c_str(), tLineIter, tValues.size() );
+			tSuccess = false;
+		}
+		else if( *std::min_element( tValues.begin(), tValues.end() ) < 0 || *std::max_element( tValues.begin(), tValues.end() ) > (int)tAxis ) {
+			printf( "ERROR: Puzzle ending at \'%s\':%zu has values outside of [0, %zu].\n", iPath.c_str(), tLineIter, tAxis );
+			tSuccess = false;
+		}
+		else {
+			std::stringstream tName;
+			tName << iPath << "#" << ( oPuzzles.size() - tFirst );
+			SudokuPuzzle tPuzzle( tName.str(), tAxis );
+			tPuzzle.mGivens = tValues;
+			oPuzzles.push_back( tPuzzle );
+		}
+		tValues.clear();
+	};
+	while( std::getline( tFile, tLine ) ) {
+		tLineIter++;
+		// Strip the carriage return of CRLF line endings:
+		if( !tLine.empty() && tLine[ tLine.size() - 1 ] == '\r' ) { tLine.erase( tLine.size() - 1 ); }
+		// Skip comments:
+		if( !tLine.empty() && tLine[ 0 ] == '#' ) { continue; }
+		// Strip whitespace to test for the compact format:
+		std::string tCompact;
+		for(size_t i = 0; i < tLine.size(); i++) {
+			if( !isspace( (unsigned char)tLine[ i ] ) ) { tCompact += tLine[ i ]; }
+		}
+		if( tCompact.empty() ) {
+			tFlush();
+		}
+		else if( tValues.empty() && tCompact.size() == 81 && tCompact.size() == tLine.size() ) {
+			// Read a compact puzzle:
+			tValues.resize( 81 );
+			for(size_t i = 0; i < 81; i++) {
+				tValues[ i ] = isdigit( (unsigned char)tCompact[ i ] ) ? ( tCompact[ i ] - '0' ) : 0;
+			}
+			tFlush();
+		}
+		else {
+			// Read grid values:
+			std::stringstream tStream( tLine );
+			std::string       tToken;
+			while( tStream >> tToken ) {
+				tValues.push_back( ( tToken == "." ) ? 0 : atoi( tToken.c_str() ) );
+			}
+		}
+	}
+	tFlush();
+	return tSuccess;
+}
@@ -7,9 +7,20 @@
 //////////////////////////////////////////////////
 
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <ctime>
+#include <cctype>
+#include <cstdlib>
 
 #include "Population.h"
 #include "Constants.h"
+#include "SudokuConstraints.h"
+#include "SudokuGenome.h"
+#include "SudokuPuzzle.h"
 
 #include "Solver.h"
 
@@ -53,56 +64,289 @@ static int init_test_incorrect[] = {
 	3, 7, 4, 9, 6, 2, 8, 1, 1
 };
 
+/**
+ * @brief Returns a monotonic wall-clock time in milliseconds, used to time each round. Wall time includes the work of
+ * any evaluation workers a round starts, but concurrent rounds share the machine, so use --jobs 1 for uncontended
+ * round timings. (std::chrono is used because per-thread CPU clocks are unavailable on the 10.8 deployment target.)
+ */
+static double getRoundTimeNow()
+{
+	return chrono::duration<double, milli>( chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * @brief The outcome of a single test round
+ */
+struct RoundResult {
+	double				mDuration;
+	size_t				mGenerationCount;
+	std::vector<int>	mWinState;
+};
+
+/**
+ * @brief Runs a single test round on the calling thread and records its outcome
+ */
+static void runRound(const SudokuPuzzle& iPuzzle, const SudokuConstraints& iConstraints, const SudokuGenome& iGenome,
+					 const bool& iUseGenome, const size_t& iMaxGenerations, RoundResult& oResult)
+{
+	// Start timer:
+	double tTimeStart = getRoundTimeNow();
+	// Create new population instance:
+	Population<int>* mPopulation = new Population<int>( getPopulationSize(), iPuzzle.getTileCount(), kMutationRate );
+	// Set function bindings:
+	if( iUseGenome ) {
+		iGenome.bind( *mPopulation );
+	}
+	else {
+		// Wrap the team functions to keep givens locked:
+		mPopulation->setInitializeFunction( [&iPuzzle](int* oBoard, const size_t& iTileCount) {
+			randomBoard( oBoard, iTileCount );
+			iPuzzle.applyGivens( oBoard );
+		} );
+		mPopulation->setFitnessFunction( fitnessFunc );
+		mPopulation->setCrossoverFunction( [&iPuzzle](const int* iBoardA, const int* iBoardB, int* oBoard, const size_t& iTileCount) {
+			crossoverFunc( iBoardA, iBoardB, oBoard, iTileCount );
+			iPuzzle.applyGivens( oBoard );
+		} );
+		mPopulation->setMutationFunction( [&iPuzzle](int* ioBoard, const size_t& iTileCount, const float& iMutationRate) {
+			mutateFunc( ioBoard, iTileCount, iMutationRate );
+			iPuzzle.applyGivens( ioBoard );
+		} );
+		mPopulation->setWinFunction( [&iConstraints](const int* iBoard, const size_t& iTileCount) { return iConstraints.getBoardWin( iBoard ); } );
+	}
+	mPopulation->setPrintFunction( printBoard );
+	// Initialize the population:
+	mPopulation->initialize();
+	// While running flag is set, keep running algorithm:
+	while( mPopulation->isRunning() && ( iMaxGenerations == 0 || mPopulation->getGenerationNumber() < iMaxGenerations ) ) {
+		mPopulation->runGeneration();
+	}
+	// End timer:
+	double tTimeStop = getRoundTimeNow();
+	// Record outcome:
+	oResult.mDuration        = tTimeStop - tTimeStart;
+	oResult.mGenerationCount = mPopulation->getGenerationNumber();
+	oResult.mWinState.clear();
+	if( mPopulation->getWinState() ) {
+		oResult.mWinState.assign( mPopulation->getWinState(), mPopulation->getWinState() + iPuzzle.getTileCount() );
+	}
+	// Delete population:
+	delete mPopulation;
+}
+
+/**
+ * @brief Prints the mean, median, 95th percentile and standard deviation of the given values
+ */
+static void printStatistics(const string& iLabel, vector<float> iValues, const string& iUnit)
+{
+	if( iValues.empty() ) { return; }
+	sort( iValues.begin(), iValues.end() );
+	size_t tCount = iValues.size();
+	float  tSum   = 0.0f;
+	float  tSqSum = 0.0f;
+	for(size_t i = 0; i < tCount; i++) {
+		tSum   += iValues[ i ];
+		tSqSum += iValues[ i ] * iValues[ i ];
+	}
+	float tMean   = tSum / (float)tCount;
+	float tMedian = ( tCount % 2 ) ? iValues[ tCount / 2 ] : ( 0.5f * ( iValues[ tCount / 2 - 1 ] + iValues[ tCount / 2 ] ) );
+	float tP95    = iValues[ std::min( tCount - 1, (size_t)std::ceil( 0.95f * tCount ) - 1 ) ];
+	float tStdDev = std::sqrt( std::max( tSqSum / (float)tCount - tMean * tMean, 0.0f ) );
+	cout << "\t" << iLabel << ": mean " << tMean << ", median " << tMedian << ", p95 " << tP95 << ", stddev " << tStdDev << iUnit << endl;
+}
+
+/**
+ * @brief The aggregate outcome of a set of test rounds
+ */
+struct PuzzleResult {
+	vector<float>	mDurations;
+	vector<float>	mGenCounts;
+	vector<float>	mSolvedGenCounts;
+	size_t			mSolved;
+	
+	PuzzleResult() : mSolved( 0 ) {}
+};
+
+/**
+ * @brief Runs every test round of the given puzzle on a pool of threads and prints the puzzle score. A repair budget
+ * selects the hybrid permutation genome. Each round seeds its thread's generator from its own index,
+ * so a round's outcome does not depend on scheduling.
+ */
+static void runPuzzle(const SudokuPuzzle& iPuzzle, const bool& iPermutation, const size_t& iRepairBudget, const size_t& iMaxGenerations,
+					  const size_t& iJobCount, const uint32_t& iSeed, PuzzleResult& oResult)
+{
+	SudokuConstraints tConstraints( iPuzzle.getTileCount(), getTileValueMin() );
+	SudokuGenome      tGenome( tConstraints, &iPuzzle.mGivens[ 0 ] );
+	tGenome.setRepairBudget( iRepairBudget );
+	// The team functions only produce values up to getTileValueMax(), so other board sizes use the permutation genome:
+	bool tUseGenome = iPermutation || ( iRepairBudget > 0 ) || ( iPuzzle.mAxis != (size_t)getTileAxis() );
+	// Run the test rounds:
+	int                 tRoundCount = getTestRunCount();
+	vector<RoundResult> tResults( tRoundCount );
+	atomic<int>         tNextRound( 0 );
+	mutex               tPrintMutex;
+	vector<thread>      tThreads;
+	for(size_t t = 0; t < std::min( iJobCount, (size_t)tRoundCount ); t++) {
+		tThreads.push_back( thread( [&]() {
+			int i;
+			while( ( i = tNextRound++ ) < tRoundCount ) {
+				randomSeed( iSeed + (uint32_t)i );
+				runRound( iPuzzle, tConstraints, tGenome, tUseGenome, iMaxGenerations, tResults[ i ] );
+				// Report progress:
+				lock_guard<mutex> tLock( tPrintMutex );
+				if( !tResults[ i ].mWinState.empty() ) {
+					printf( "WIN STATE:\n" );
+					printBoard( &tResults[ i ].mWinState[ 0 ], iPuzzle.getTileCount() );
+				}
+				else {
+					printf( "ERROR: Cannot print valid win state!\n" );
+				}
+				cout << "Test round #" << i << " completed in " << tResults[ i ].mDuration << " milliseconds." << endl << endl;
+			}
+		} ) );
+	}
+	for(size_t t = 0; t < tThreads.size(); t++) {
+		tThreads[ t ].join();
+	}
+	// Gather analytics:
+	for(int i = 0; i < tRoundCount; i++) {
+		oResult.mDurations.push_back( (float)tResults[ i ].mDuration );
+		oResult.mGenCounts.push_back( (float)tResults[ i ].mGenerationCount );
+		if( !tResults[ i ].mWinState.empty() ) {
+			oResult.mSolvedGenCounts.push_back( (float)tResults[ i ].mGenerationCount );
+			oResult.mSolved++;
+		}
+	}
+	// Print puzzle score:
+	cout << "PUZZLE SCORE: \'" << iPuzzle.mName << "\'";
+	if( iRepairBudget > 0 ) {
+		cout << " (repair budget " << iRepairBudget << ")";
+	}
+	cout << endl;
+	cout << "\tSolved: " << oResult.mSolved << " / " << tRoundCount << endl;
+	printStatistics( "Duration", oResult.mDurations, " milliseconds (wall time per round)" );
+	printStatistics( "Generation Count", oResult.mGenCounts, "" );
+	cout << endl;
+}
+
+/**
+ * @brief Parses a non-negative decimal integer, returning false if the text is empty, signed or not a number
+ */
+static bool parseCount(const char* iText, size_t& oValue)
+{
+	if( !isdigit( (unsigned char)iText[ 0 ] ) ) { return false; }
+	char*         tEnd   = NULL;
+	unsigned long tValue = strtoul( iText, &tEnd, 10 );
+	if( *tEnd != '\0' ) { return false; }
+	oValue = (size_t)tValue;
+	return true;
+}
+
 int main(int argc, const char * argv[])
 {
+	// Create constraint engine:
+	SudokuConstraints tConstraints( getTileCount(), getTileValueMin() );
 	cout << "Performing sanity check..." << endl;
-	if( getBoardWin( init_test_correct, getTileCount() ) && !getBoardWin( init_test_incorrect, getTileCount() ) ) {
+	if( getBoardWin( init_test_correct, getTileCount() ) && !getBoardWin( init_test_incorrect, getTileCount() ) &&
+		tConstraints.getBoardWin( init_test_correct ) && !tConstraints.getBoardWin( init_test_incorrect ) ) {
 		cout << "PASSED" << endl << endl;
 	}
 	else {
 		cout << "FAILED" << endl << endl;
 		return 0;
 	}
-	cout << "Running team: \'" << kAuthorTeam << "\'" << endl << endl;
-	// Seed random:
-	srand( (unsigned int)time( NULL ) );
+	// Parse arguments (any argument that is not an option is a puzzle file):
+	bool     tPermutation    = false;
+	size_t   tMaxGenerations = 0;
+	size_t   tJobCount       = std::max( thread::hardware_concurrency(), 1u );
+	uint32_t tSeed           = (uint32_t)time( NULL );
+	size_t   tRepairBudget   = 0;
+	bool     tBenchmark      = false;
+	vector<SudokuPuzzle> tPuzzles;
+	for(int i = 1; i < argc; i++) {
+		string tArg( argv[ i ] );
+		if( tArg == "--permutation" ) {
+			tPermutation = true;
+		}
+		else if( tArg == "--max-generations" && i + 1 < argc ) {
+			if( !parseCount( argv[ ++i ], tMaxGenerations ) ) {
+				printf( "ERROR: --max-generations expects a non-negative integer, not \'%s\'.\n", argv[ i ] );
+				return 1;
+			}
+		}
+		else if( tArg == "--jobs" && i + 1 < argc ) {
+			tJobCount = std::max( atoi( argv[ ++i ] ), 1 );
+		}
+		else if( tArg == "--repair" && i + 1 < argc ) {
+			if( !parseCount( argv[ ++i ], tRepairBudget ) ) {
+				printf( "ERROR: --repair expects a non-negative integer, not \'%s\'.\n", argv[ i ] );
+				return 1;
+			}
+		}
+		else if( tArg == "--benchmark" ) {
+			tBenchmark = true;
+		}
+		else if( tArg == "--seed" && i + 1 < argc ) {
+			tSeed = (uint32_t)strtoul( argv[ ++i ], NULL, 10 );
+		}
+		else if( !loadPuzzles( tArg, tPuzzles ) ) {
+			return 1;
+		}
+	}
+	// Default to a blank board:
+	if( tPuzzles.empty() ) {
+		tPuzzles.push_back( SudokuPuzzle() );
+	}
+	// Benchmarks need a repair budget to compare against:
+	if( tBenchmark && tRepairBudget == 0 ) {
+		tRepairBudget = 16;
+	}
+	cout << "Running team: \'" << kAuthorTeam << "\'" << ( tPermutation ? " (permutation genome)" : "" ) << endl;
+	cout << "Running " << tJobCount << " rounds concurrently with seed " << tSeed << endl << endl;
 	// Prepare analytics:
-	size_t tAvgDuration = 0;
-	size_t tAvgGenCount = 0;
-	// Run each test round:
-	for(int i = 0; i < getTestRunCount(); i++) {
-		// Start timer:
-		size_t tTimeStart = getTimeNow();
-		// Create new population instance:
-		Population<int>* mPopulation = new Population<int>( getPopulationSize(), getTileCount(), kMutationRate );
-		// Set function bindings:
-		mPopulation->setInitializeFunction( randomBoard );
-		mPopulation->setFitnessFunction( fitnessFunc );
-		mPopulation->setCrossoverFunction( crossoverFunc );
-		mPopulation->setMutationFunction( mutateFunc );
-		mPopulation->setPrintFunction( printBoard );
-		// Initialize the population:
-		mPopulation->initialize();
-		// While running flag is set, keep running algorithm:
-		while( mPopulation->isRunning() ) {
-			mPopulation->runGeneration();
+	PuzzleResult tTotals;
+	size_t       tTimeStart = getTimeNow();
+	// Run each puzzle:
+	for(size_t p = 0; p < tPuzzles.size(); p++) {
+		const SudokuPuzzle& tPuzzle = tPuzzles[ p ];
+		uint32_t            tPuzzleSeed = tSeed + (uint32_t)( p * getTestRunCount() );
+		cout << "Puzzle \'" << tPuzzle.mName << "\': " << tPuzzle.mAxis << "x" << tPuzzle.mAxis << ", " << tPuzzle.getGivenCount() << " givens" << endl << endl;
+		if( tBenchmark ) {
+			// Compare the pure GA baseline, the permutation GA and the hybrid on the same seeds:
+			const char* tArmNames[ 3 ]       = { "Pure GA", "Permutation GA", "Hybrid" };
+			bool        tArmPermutation[ 3 ] = { false, true, true };
+			size_t      tArmRepair[ 3 ]      = { 0, 0, tRepairBudget };
+			PuzzleResult tArms[ 3 ];
+			double       tArmWallTimes[ 3 ];
+			for(int a = 0; a < 3; a++) {
+				double tArmStart = getRoundTimeNow();
+				runPuzzle( tPuzzle, tArmPermutation[ a ], tArmRepair[ a ], tMaxGenerations, tJobCount, tPuzzleSeed, tArms[ a ] );
+				tArmWallTimes[ a ] = getRoundTimeNow() - tArmStart;
+			}
+			cout << "BENCHMARK: \'" << tPuzzle.mName << "\' (repair budget " << tRepairBudget << ")" << endl;
+			for(int a = 0; a < 3; a++) {
+				cout << "\t" << tArmNames[ a ] << ": solved " << tArms[ a ].mSolved << " / " << tArms[ a ].mDurations.size()
+					 << ", wall time " << tArmWallTimes[ a ] << " milliseconds" << endl;
+				printStatistics( "\tGeneration Count (solved rounds)", tArms[ a ].mSolvedGenCounts, "" );
+			}
+			cout << endl;
+			continue;
 		}
-		// End timer:
-		size_t tTimeStop = getTimeNow();
+		PuzzleResult tResult;
+		runPuzzle( tPuzzle, tPermutation, tRepairBudget, tMaxGenerations, tJobCount, tPuzzleSeed, tResult );
 		// Update analytics:
-		tAvgDuration += ( tTimeStop - tTimeStart );
-		tAvgGenCount += mPopulation->getGenerationNumber();
-		// Print win state:
-		mPopulation->printWinState();
-		// Delete population:
-		delete mPopulation;
-		// Report progress:
-		cout << "Test round #" << i << " completed." << endl << endl;
+		tTotals.mDurations.insert( tTotals.mDurations.end(), tResult.mDurations.begin(), tResult.mDurations.end() );
+		tTotals.mGenCounts.insert( tTotals.mGenCounts.end(), tResult.mGenCounts.begin(), tResult.mGenCounts.end() );
+		tTotals.mSolved += tResult.mSolved;
 	}
 	// Print score:
-	cout << "TEAM SCORE: \'" << kAuthorTeam << "\'" << endl;
-	cout << "\tAverage Duration: " << ( (float)tAvgDuration / (float)getTestRunCount() ) << " milliseconds" << endl;
-	cout << "\tAverage Generation Count: " << ( (float)tAvgGenCount / (float)getTestRunCount() ) << endl;
+	if( !tBenchmark ) {
+		cout << "TEAM SCORE: \'" << kAuthorTeam << "\'" << endl;
+		cout << "\tSolved: " << tTotals.mSolved << " / " << tTotals.mDurations.size() << endl;
+		printStatistics( "Duration", tTotals.mDurations, " milliseconds (wall time per round)" );
+		printStatistics( "Generation Count", tTotals.mGenCounts, "" );
+	}
+	cout << "\tWall Time: " << ( getTimeNow() - tTimeStart ) << " milliseconds" << endl;
 	// Return:
     return 0;
 }
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "cinder/gl/Vbo.h"
+
 #include "GuiPlot.h"
 
 typedef std::shared_ptr<class PolynomialData>	PolynomialDataRef;			//!< A shared pointer to a PlotterData item
@@ -39,6 +41,31 @@ protected:
 	bool			mDrawDeriv;		//!< Flags whether derivative data should be drawn
 	bool			mDirty;			//!< Flags whether raster data needs updating
 	
+	ci::Rectf		mDrawBounds;	//!< The visible range of the plot
+	ci::Vec2f		mDrawPixelDim;	//!< The size of the plot in pixels (zero if unknown)
+	
+	std::vector<ci::Vec3f>	mDrawPositions;		//!< The cached formula samples followed by the cached derivative samples
+	size_t					mDrawFormulaCount;	//!< The number of cached formula samples
+	size_t					mDrawDerivCount;	//!< The number of cached derivative samples
+	ci::gl::VboMeshRef		mDrawMesh;			//!< The draw mesh holding the cached samples
+	bool					mDrawMeshStale;		//!< Flags whether the cached samples need uploading to the draw mesh
+	
+	/** @brief Resamples the formula and derivative */
+	void					updateSamples();
+	
+	/** @brief Uploads the cached samples to the draw mesh */
+	void					updateDrawMesh();
+	
+	/** @brief Appends samples of the formula or derivative over the visible range, subdividing where the curve deviates from a straight line on screen */
+	void					sampleAdaptive(const bool& iDerivative, std::vector<ci::Vec3f>& oPositions) const;
+	
+	/** @brief Appends samples between two points, excluding the first and including the last, while the midpoint error exceeds the tolerance */
+	void					subdivide(const bool& iDerivative, const ci::Vec2f& iPtA, const ci::Vec2f& iPtB, const ci::Vec2f& iPixelScale,
+									  const int& iDepth, std::vector<ci::Vec3f>& oPositions) const;
+	
+	/** @brief Computes the formula or derivative output value for a given input */
+	float					getSampleValue(const bool& iDerivative, const float& iParam) const;
+	
 public:
 	
 	/** @brief Basic Constructor */
@@ -55,6 +82,12 @@ public:
 	/** @brief An overloadable draw method */
 	virtual void			draw();
 	
+	/** @brief Flags the raster data for updating when the plot's visible range or pixel size changes */
+	virtual void			setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim);
+	
+	/** @brief Appends the formula and (stippled) derivative strips for batched drawing */
+	virtual bool			appendStrips(PlotterStripVec& oStrips);
+	
 	/** @brief Sets the parameter range for the drawing of the polynomial formula */
 	void					setDrawParameters(const float& iParamIn, const float& iParamOut,
 											  const bool& iDrawFormula = true, const bool& iDrawDeriv = true,
@@ -63,7 +96,7 @@ public:
 	/** @brief Adds a component with the given coefficient and exponent values to the formula */
 	void					addComponent(const float& iCoeff, const float& iExpon);
 	
-	/** @brief Returns a reference to the components vector */
+	/** @brief Returns a reference to the components vector and flags the raster data for updating */
 	ComponentVec&			getComponents();
 	
 	/** @brief Returns a const reference to the components vector */
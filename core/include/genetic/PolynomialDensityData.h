@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include "cinder/Surface.h"
+#include "cinder/gl/Texture.h"
+
+#include "PolynomialPopulation.h"
+
+typedef std::shared_ptr<class PolynomialDensityData>	PolynomialDensityDataRef;	//!< A shared pointer to a PolynomialDensityData item
+
+/**
+ * @brief A PlotterData item that overlays every curve in a PopulationSnapshot as a density texture.
+ * The curves are rasterized on the CPU only when the snapshot or the plot's visible range changes,
+ * so each redraw costs a single textured quad regardless of the population size.
+ */
+class PolynomialDensityData : public PlotterData {
+protected:
+	
+	PopulationSnapshotRef	mSnapshot;		//!< The population snapshot being drawn
+	float					mResolution;	//!< The texture resolution relative to the plot's pixel size
+	ci::Rectf				mDrawBounds;	//!< The visible range of the plot
+	ci::Vec2f				mDrawPixelDim;	//!< The size of the plot in pixels (zero if unknown)
+	std::vector<uint32_t>	mDensity;		//!< The number of curves crossing each texel
+	ci::Surface8u			mSurface;		//!< The tone-mapped density
+	ci::gl::Texture			mTexture;		//!< The density texture
+	bool					mDirty;			//!< Flags whether the density texture needs updating
+	
+public:
+	
+	/** @brief Basic constructor */
+	PolynomialDensityData(const ci::ColorA& iColor = ci::ColorA( 0.0, 1.0, 1.0, 0.75 ), const float& iResolution = 0.5);
+	
+	/** @brief Virtual destructor */
+	virtual ~PolynomialDensityData();
+	
+	/** @brief Returns a clone of this item */
+	virtual PlotterData*	clone();
+	
+	/** @brief Draws the density texture over the plot's visible range */
+	virtual void			draw();
+	
+	/** @brief Flags the density texture for updating when the plot's visible range or pixel size changes */
+	virtual void			setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim);
+	
+	/** @brief Sets the population snapshot to be drawn, flagging the density texture for updating if it differs from the current one */
+	void					setSnapshot(PopulationSnapshotRef iSnapshot);
+	
+	/** @brief Returns the population snapshot being drawn */
+	PopulationSnapshotRef	getSnapshot() const;
+	
+	/** @brief Sets the texture resolution relative to the plot's pixel size */
+	void					setResolution(const float& iResolution);
+	
+	/** @brief Returns the texture resolution relative to the plot's pixel size */
+	const float&			getResolution() const;
+	
+protected:
+	
+	/** @brief Rasterizes every curve in the snapshot into the density grid and uploads the tone-mapped result */
+	void					updateTexture();
+};
@@ -8,14 +8,46 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "cinder/Rand.h"
 #include "cinder/Thread.h"
 #include "cinder/ConcurrentCircularBuffer.h"
 
 #include "GuiPlot.h"
+#include "GuiPlotSeries.h"
 #include "PolynomialData.h"
 #include "PolynomialAssertion.h"
 
+/** @brief An enumeration of the responses available when a population stagnates */
+enum StagnationAction
+{
+	STAGNATION_IGNORE,		//!< Take no action
+	STAGNATION_STOP,		//!< Stop the evolutionary process
+	STAGNATION_IMMIGRANTS,	//!< Replace a portion of the population with freshly initialized individuals
+	STAGNATION_MUTATION		//!< Raise the mutation rate until the population improves again
+};
+
+/** @brief An enumeration of the available mutation rate controllers */
+enum MutationControl
+{
+	MUTATION_FIXED,			//!< The mutation rate remains constant
+	MUTATION_ONE_FIFTH,		//!< The rate rises while more than a fifth of the children outscore their parents and falls otherwise
+	MUTATION_DIVERSITY,		//!< The rate rises as the coefficient diversity falls
+	MUTATION_SELF_ADAPTIVE	//!< Each individual carries its own rate, which is inherited and perturbed log-normally
+};
+
+/**
+ * @brief The components and scores of every individual in one generation, published for display on other threads
+ */
+struct PopulationSnapshot {
+	size_t										mGeneration;	//!< The generation number
+	std::vector<PolynomialData::ComponentVec>	mGenes;			//!< The components of each individual
+	std::vector<float>							mScores;		//!< The score of each individual
+};
+
+typedef std::shared_ptr<const PopulationSnapshot>	PopulationSnapshotRef;	//!< A shared pointer to an immutable PopulationSnapshot
+
 /** 
  * @brief A population container and evolutionary process facilitation class for polynomial data and assertions 
  */
@@ -24,6 +56,83 @@ public:
 	
 	typedef std::shared_ptr<std::thread>					ThreadRef;	//!< A shared_ptr thread wrapper type
 	typedef ci::ConcurrentCircularBuffer<PolynomialDataRef>	Buffer;		//!< A concurrent buffer type
+	
+	/**
+	 * @brief A chainable description of the optional settings of the evolutionary process
+	 */
+	class Format {
+	protected:
+		
+		size_t				mStagnationWindow;		//!< The number of generations without improvement after which the population is stagnant
+		float				mStagnationEpsilon;		//!< The minimum score change considered an improvement
+		float				mDiversityThreshold;	//!< The score standard deviation below which the population is stagnant
+		StagnationAction	mStagnationAction;		//!< The response to stagnation
+		float				mStagnationParam;		//!< The immigrant fraction or mutation multiplier applied on stagnation
+		MutationControl		mMutationControl;		//!< The mutation rate controller
+		float				mMutationRateMin;		//!< The lower bound of the controlled mutation rate
+		float				mMutationRateMax;		//!< The upper bound of the controlled mutation rate
+		PlotSeriesRef		mBestSeries;			//!< The series receiving each generation's best score
+		PlotSeriesRef		mAverageSeries;			//!< The series receiving each generation's average score
+		PlotSeriesRef		mWorstSeries;			//!< The series receiving each generation's worst score
+		size_t				mSnapshotInterval;		//!< The number of generations between published snapshots (zero disables publishing)
+		
+	public:
+		
+		/** @brief Default constructor (stagnation detection and snapshot publishing disabled) */
+		Format();
+		
+		/** @brief Sets the stagnation criteria. A window of zero disables stagnation detection */
+		Format&					stagnation(const size_t& iWindow, const float& iEpsilon = 0.0, const float& iDiversityThreshold = 0.0);
+		
+		/** @brief Sets the response to stagnation, along with its immigrant fraction or mutation multiplier (a multiplier of 1 or less becomes 2) */
+		Format&					stagnationAction(const StagnationAction& iAction, const float& iParam = 0.0);
+		
+		/** @brief Sets the mutation rate controller, which keeps the rate within [ iMinRate, iMaxRate ] */
+		Format&					mutationControl(const MutationControl& iControl, const float& iMinRate, const float& iMaxRate);
+		
+		/** @brief Sets the series into which the evolution thread pushes each generation's best, average and worst scores (any may be NULL) */
+		Format&					fitnessSeries(PlotSeriesRef iBest, PlotSeriesRef iAverage = PlotSeriesRef(), PlotSeriesRef iWorst = PlotSeriesRef());
+		
+		/** @brief Publishes a snapshot of the population every iInterval generations. Zero disables publishing, which skips copying the population */
+		Format&					snapshotInterval(const size_t& iInterval);
+		
+		/** @brief Returns the stagnation window */
+		const size_t&			getStagnationWindow() const;
+		
+		/** @brief Returns the stagnation epsilon */
+		const float&			getStagnationEpsilon() const;
+		
+		/** @brief Returns the diversity collapse threshold */
+		const float&			getDiversityThreshold() const;
+		
+		/** @brief Returns the stagnation action */
+		const StagnationAction&	getStagnationAction() const;
+		
+		/** @brief Returns the stagnation action parameter */
+		const float&			getStagnationParam() const;
+		
+		/** @brief Returns the mutation rate controller */
+		const MutationControl&	getMutationControl() const;
+		
+		/** @brief Returns the lower bound of the controlled mutation rate */
+		const float&			getMutationRateMin() const;
+		
+		/** @brief Returns the upper bound of the controlled mutation rate */
+		const float&			getMutationRateMax() const;
+		
+		/** @brief Returns the best score series */
+		PlotSeriesRef			getBestSeries() const;
+		
+		/** @brief Returns the average score series */
+		PlotSeriesRef			getAverageSeries() const;
+		
+		/** @brief Returns the worst score series */
+		PlotSeriesRef			getWorstSeries() const;
+		
+		/** @brief Returns the number of generations between published snapshots */
+		const size_t&			getSnapshotInterval() const;
+	};
+	
 private:
 
 	AssertionGroup		mAssertionGroup;	//!< The AssertionGroup determining individual fitness
@@ -32,16 +141,30 @@ private:
 	size_t				mGenerationIter;	//!< The current generation number
 	size_t				mGenerationMax;		//!< The maximum allowed number of generations in the evolutionary process
 	float				mMutationRate;		//!< The rate of individual mutation
+	float				mMutationRateBase;	//!< The initial rate of individual mutation
 	float				mPerfectThreshold;	//!< The perfect score threshold value
+	Format				mFormat;			//!< The optional settings of the evolutionary process
+	size_t				mStagnantGenerations;	//!< The number of generations since the last improvement
+	float				mBestScoreRecord;	//!< The highest best score observed so far
+	float				mAvgScoreRecord;	//!< The highest average score observed so far
+	bool				mStagnated;			//!< Flags whether the most recent stagnation check was triggered
+	std::vector<float>	mCoeffDeviations;	//!< The standard deviation of each coefficient across the population
+	float				mDiversity;			//!< The mean coefficient deviation, relative to that of a random population
+	std::mutex			mStatsMutex;		//!< Guards the diversity metrics, which are read from other threads
+	std::vector<float>	mParentScores;		//!< The best parent score of each individual, used by the 1/5th success rule
+	std::vector<float>	mIndividualRates;	//!< The mutation rate of each individual, used by self-adaptation
 	bool				mRunning;			//!< Flags whether the evolutionary process is currently running
 	ThreadRef			mThread;			//!< The thread upon which the evolutionary process is run
 	Buffer				mBuffer;			//!< A concurrent circular container storing buffered outputs
+	PopulationSnapshotRef	mSnapshot;		//!< The most recently published snapshot of the population
+	std::mutex			mSnapshotMutex;		//!< Guards the published snapshot
 			
 public:
 	
 	/** @brief Basic constructor */
 	PolynomialPopulation(const AssertionGroup& iAssertionGroup, const size_t& iPopulationSize,
-						 const size_t& iMaxGenerationCount, const float& iMutationRate, const float& iPerfectScore = 1e12);
+						 const size_t& iMaxGenerationCount, const float& iMutationRate, const float& iPerfectScore = 1e12,
+						 const Format& iFormat = Format());
 	
 	/** @brief Destructor */
 	~PolynomialPopulation();
@@ -52,11 +175,35 @@ public:
 	/** @brief Pops an item from the internal buffer and returns it in a thread-safe manner */
 	PolynomialDataRef	getUpdate();
 	
+	/** @brief Returns the population's coefficient diversity (1 for a random population, 0 when all individuals share their coefficients) */
+	float				getDiversity();
+	
+	/** @brief Returns the standard deviation of each coefficient across the population */
+	std::vector<float>	getCoefficientDeviations();
+	
+	/** @brief Returns the most recently published snapshot of the population (NULL before the first one is published, or if publishing is disabled) */
+	PopulationSnapshotRef	getSnapshot();
+	
 private:
 	
 	/** @brief An internal threaded function that computes each stage of the evolutionary process */
 	void				computeEvolution();
 		
+	/** @brief An internal function that updates the stagnation state from the current generation's score statistics */
+	bool				updateStagnation(const float& iBestScore, const float& iScoreSum, const float& iScoreSqSum);
+	
+	/** @brief An internal function that publishes a snapshot of the current generation and its scores */
+	void				publishSnapshot(const float* iScores);
+	
+	/** @brief An internal function that computes the coefficient diversity metrics in a single pass over the population */
+	void				updateDiversity();
+	
+	/** @brief An internal function that updates the population-wide mutation rate according to the active controller */
+	void				updateMutationRate(const float* iScores);
+	
+	/** @brief An internal function that returns a child's mutation rate from those of its parents */
+	float				inheritMutationRate(const float& iRateA, const float& iRateB);
+	
 	/** @brief An internal function that creates an initial gene pool member */
 	PolynomialDataRef	initializationFunction();
 	
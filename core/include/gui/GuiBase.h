@@ -42,9 +42,22 @@ public:
 	typedef GuiBaseDeque::iterator			GuiBaseDequeIter;	//!< An iterator type for a deque of GuiBase* nodes
 	typedef GuiBaseDeque::reverse_iterator	GuiBaseDequeRiter;	//!< A reverse iterator type for a deque of GuiBase* nodes
 	typedef GuiBaseDeque::const_iterator	GuiBaseDequeCiter;	//!< A const iterator type for a deque of GuiBase* nodes
+	typedef std::vector<GuiBase*>			GuiBaseVec;			//!< A vector of GuiBase* nodes
+	typedef GuiBaseVec::iterator			GuiBaseVecIter;		//!< An iterator type for a vector of GuiBase* nodes
+	typedef GuiBaseVec::const_iterator		GuiBaseVecCiter;	//!< A const iterator type for a vector of GuiBase* nodes
 	
 protected:
 	
+	typedef bool (GuiBase::*MouseHandler)(ci::app::MouseEvent);	//!< A pointer to one of the node's mouse event-handlers
+	
+	/**
+	 * @brief A node held in a hit index, along with its cached screen rect
+	 */
+	struct HitEntry {
+		GuiBase*				mNode;	//!< The indexed node
+		ci::Rectf				mRect;	//!< The node's screen rect when the index was built
+	};
+	
 	std::string				mName;		//!< The node's name
 	bool					mVisible;	//!< Flags whether the node is visible
 	
@@ -58,6 +71,31 @@ protected:
 	GuiBase*				mParent;	//!< A pointer to the node's parent
 	GuiBaseDeque			mChildren;	//!< A deque of the node's children
 	
+	mutable ci::Vec2f		mLayoutPosition;		//!< The cached screen position
+	mutable ci::Vec2f		mLayoutLocalPosition;	//!< The cached local position within the parent
+	mutable ci::Vec2f		mLayoutDimension;		//!< The cached screen dimension
+	mutable ci::Vec2f		mLayoutWindowSize;		//!< The window size at the last layout of a root node
+	mutable bool			mLayoutDirty;			//!< Flags whether the cached layout needs updating
+	mutable ci::Rectf		mLayoutBounds;			//!< The cached screen bounds of the node and its descendants
+	mutable bool			mBoundsDirty;			//!< Flags whether the cached bounds need updating
+	
+	bool					mClipChildren;			//!< Flags whether the node's children are clipped to its rect
+	ci::Rectf				mDrawClip;				//!< The screen rect clipping the node during its last draw
+	bool					mDrawClipped;			//!< Flags whether the node was scissored during its last draw
+	
+	bool								mHitIndexEnabled;	//!< Flags whether mouse events are dispatched through the hit index
+	bool								mHitIndexDirty;		//!< Flags whether the hit index needs rebuilding
+	float								mHitCellSize;		//!< The size of a hit index grid cell in points
+	int									mHitCols;			//!< The number of hit index grid columns
+	int									mHitRows;			//!< The number of hit index grid rows
+	std::vector<HitEntry>				mHitEntries;		//!< The indexed nodes, in mouse event dispatch order
+	std::vector< std::vector<size_t> >	mHitCells;			//!< The indices of the entries overlapping each grid cell
+	GuiBaseVec							mHitHover;			//!< The indexed nodes under the cursor at the last mouseMove or mouseDrag event
+	GuiBaseVec							mHitCapture;		//!< The indexed nodes under the cursor at the last mouseDown event
+	GuiBaseVec							mHitMoved;			//!< The indexed nodes whose layout has changed since the index was last updated
+	size_t								mHitOrder;			//!< The node's dispatch order within the enclosing hit index
+	bool								mHitHandled;		//!< Flags whether a descendant has handled the event being dispatched
+	
 public:
 	
 	/** @brief Basic constructor */
@@ -203,4 +241,75 @@ public:
 	
 	/** @brief Returns the node's screen y-dimension */
 	float					getDimensionY() const;
+	
+	/** @brief Returns the node's screen rect */
+	ci::Rectf				getRect() const;
+	
+	/** @brief Returns the screen bounds of the node and its descendants */
+	ci::Rectf				getBounds() const;
+	
+	/** @brief Flags the cached layout of this node and its descendants for updating */
+	void					invalidateLayout();
+	
+	/** @brief Sets whether the node's children are clipped to its rect (children entirely outside it are not drawn) */
+	void					setClipChildren(const bool& iClipChildren);
+	
+	/** @brief Returns true if the node's children are clipped to its rect */
+	const bool&				getClipChildren() const;
+	
+	/** @brief Sets whether mouse events are dispatched to the descendants under the cursor through a spatial index rather than to every descendant */
+	void					setHitIndexEnabled(const bool& iEnabled);
+	
+	/** @brief Returns true if mouse events are dispatched through a spatial index */
+	const bool&				getHitIndexEnabled() const;
+	
+	/** @brief Sets the size of a hit index grid cell in points */
+	void					setHitCellSize(const float& iCellSize);
+	
+	/** @brief Returns the size of a hit index grid cell in points */
+	const float&			getHitCellSize() const;
+	
+protected:
+	
+	/** @brief Flags the cached layout and hit index of this node and its descendants for updating */
+	void					invalidateSubtreeLayout();
+	
+	/** @brief Rebuilds the hit index from the cached screen rects of this node and its descendants */
+	void					updateHitIndex();
+	
+	/** @brief Appends this node and its descendants to the given hit entries, in mouse event dispatch order */
+	void					appendHitEntries(std::vector<HitEntry>& oEntries);
+	
+	/** @brief Rebuilds the hit index if it is dirty or the window has been resized, otherwise re-indexes the nodes that have moved */
+	void					validateHitIndex();
+	
+	/** @brief Re-indexes the given node and those of its descendants whose screen rects have changed. Returns false if a node is not held by this index. */
+	bool					moveHitEntries(GuiBase* iNode);
+	
+	/** @brief Adds the given entry to, or removes it from, the grid cells overlapping its rect */
+	void					updateHitCells(const size_t& iEntry, const bool& iInsert);
+	
+	/**
+	 * @brief Dispatches a mouse event through the hit index to the nodes under the cursor and the given extra nodes,
+	 * skipping a node's handler if one of its descendants has handled the event. Returns true if the event was handled
+	 */
+	bool					dispatchIndexed(ci::app::MouseEvent iEvent, MouseHandler iHandler, const GuiBaseVec& iExtras, GuiBaseVec* oHits);
+	
+	/** @brief Invalidates the layout of a root node if the window has been resized since its last layout */
+	void					validateLayout();
+	
+	/** @brief Computes and caches the node's screen position and dimension from its parent's cached layout */
+	void					updateLayout() const;
+	
+	/** @brief Draws the node and its visible descendants within the given screen clip rect, assuming that its ancestors are visible */
+	void					deepDrawVisible(const ci::Rectf& iClip, const bool& iClipped);
+	
+	/** @brief Enables a scissor region covering the given screen rect within the node's clip rect */
+	void					beginClip(const ci::Rectf& iRect) const;
+	
+	/** @brief Restores the scissor region in effect before beginClip() */
+	void					endClip() const;
+	
+	/** @brief Sets the scissor box to the given screen rect */
+	void					applyScissor(const ci::Rectf& iRect) const;
 };
\ No newline at end of file
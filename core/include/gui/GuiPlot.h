@@ -12,6 +12,8 @@
 #include "GuiText.h"
 #include "GuiPlotData.h"
 
+#include "cinder/gl/Vbo.h"
+
 /**
  * @brief A 2D plotting widget
  */
@@ -36,6 +38,26 @@ protected:
 	
 	bool					mDirty;				//!< Flags whether internal formatting needs updating
 	
+	/**
+	 * @brief A set of line strips within the batch mesh that share a stroke weight and stipple setting
+	 */
+	struct StripBatch {
+		float					mStrokeWeight;	//!< The strips' stroke weight
+		bool					mStipple;		//!< Flags whether the strips are drawn with a stippled line
+		std::vector<GLint>		mFirsts;		//!< The index of each strip's first vertex in the batch mesh
+		std::vector<GLsizei>	mCounts;		//!< The number of vertices in each strip
+	};
+	
+	ci::gl::VboMeshRef		mBatchMesh;			//!< The cached origin, grid and input vertices
+	size_t					mOriginCount;		//!< The number of origin line vertices at the start of the batch mesh
+	size_t					mGridCount;			//!< The number of grid line vertices following the origin lines
+	std::vector<StripBatch>	mStripBatches;		//!< The batched input strips, grouped by stroke style
+	PlotterDataRefVec		mUnbatchedInputs;	//!< Inputs that cannot be batched and are drawn individually
+	std::vector<uint32_t>	mInputRevisions;	//!< The revision of each input when the batch mesh was built
+	std::vector<bool>		mInputBatched;		//!< Flags whether each input's strips are held in the batch mesh
+	ci::Vec2f				mBatchDim;			//!< The plot dimension when the batch mesh was built
+	bool					mBatchDirty;		//!< Flags whether the batch mesh needs rebuilding
+	
 public:
 	
 	/** @brief Basic constructor */
@@ -109,6 +131,15 @@ protected:
 	/** @brief A protected method that is evoked automatically when the widget requires updating */
 	void					deepRecomputeFormatting();
 	
+	/** @brief Rebuilds the batch mesh if the range, dimension, styling or any of the batched inputs has changed since it was built */
+	void					updateBatches(const ci::Vec2f& iDim);
+	
+	/** @brief Rebuilds the batch mesh from the origin lines, grid lines and batchable input strips */
+	void					rebuildBatches(const ci::Vec2f& iDim);
+	
+	/** @brief Draws the batch mesh and any unbatched inputs in graph space */
+	void					drawBatches();
+	
 	/** @brief Returns a formatted string representing the input 2D coordinate */
 	std::string				getVertexLabelString(const float& iX, const float& iY);
 
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "cinder/PolyLine.h"
 
@@ -18,6 +20,22 @@ typedef PlotterDataRefVec::iterator				PlotterDataRefVecIter;		//!< An iterator
 typedef PlotterDataRefVec::reverse_iterator		PlotterDataRefVecRiter;		//!< A reverse iterator type for a vector of PlotterDataRef items
 typedef PlotterDataRefVec::const_iterator		PlotterDataRefVecCiter;		//!< A const iterator type for a vector of PlotterDataRef items
 
+/**
+ * @brief A line strip collected from a PlotterData item for batched drawing by GuiPlot
+ */
+struct PlotterStrip {
+	std::vector<ci::Vec2f>	mVertices;		//!< The strip's vertices in graph space
+	ci::ColorA				mColor;			//!< The strip's stroke color
+	float					mStrokeWeight;	//!< The strip's stroke weight
+	bool					mStipple;		//!< Flags whether the strip is drawn with a stippled line
+	
+	/** @brief Basic constructor */
+	PlotterStrip(const ci::ColorA& iColor = ci::ColorA::white(), const float& iStrokeWeight = 3.0, const bool& iStipple = false) :
+		mColor( iColor ), mStrokeWeight( iStrokeWeight ), mStipple( iStipple ) {}
+};
+
+typedef std::vector<PlotterStrip>				PlotterStripVec;			//!< A vector of PlotterStrip items
+
 /** 
  * @brief Base class representing data to be plotted by GuiPlot 
  */
@@ -26,6 +44,7 @@ protected:
 	
 	ci::ColorA	mColor;			//!< The data's stroke color
 	float		mStrokeWeight;	//!< The data's stroke weight
+	uint32_t	mRevision;		//!< Incremented whenever the data's drawn appearance changes
 	
 public:
 	
@@ -41,6 +60,15 @@ public:
 	/** @brief An overloadable draw method */
 	virtual void			draw();
 	
+	/** @brief An overloadable method informing the data of the plot's visible range and its size in pixels prior to drawing */
+	virtual void			setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim);
+	
+	/** @brief An overloadable method that appends the data's line strips for batched drawing, or returns false if the data must be drawn by draw() */
+	virtual bool			appendStrips(PlotterStripVec& oStrips);
+	
+	/** @brief Returns the data's revision number, which changes whenever its drawn appearance changes */
+	const uint32_t&			getRevision() const;
+	
 	/** @brief Sets the data's stroke color */
 	void					setStrokeColor(const ci::ColorA& iColor);
 	
@@ -55,12 +83,33 @@ public:
 };
 
 /**
- * @brief Implements a subclass of PlotterData that stores ci::PolyLine2f data
+ * @brief Implements a subclass of PlotterData that stores ci::PolyLine2f data.
+ * While the points' x-values are non-decreasing, a min/max pyramid is maintained as points are appended,
+ * so that a long trace draws at most a few vertices per pixel column of the plot.
  */
 class PolyLineData : public PlotterData {
 protected:
 	
-	ci::PolyLine2f	mData; //!< The 2D PolyLine data
+	/**
+	 * @brief The extent of an aligned run of points within the decimation pyramid
+	 */
+	struct Bucket {
+		float	mXFirst;	//!< The x-value of the run's first point
+		float	mXLast;		//!< The x-value of the run's last point
+		float	mYMin;		//!< The minimum y-value of the run
+		float	mYMax;		//!< The maximum y-value of the run
+		bool	mMinFirst;	//!< Flags whether the minimum occurs before the maximum
+	};
+	
+	typedef std::vector<Bucket>	BucketVec;	//!< A vector of Bucket items
+	
+	ci::PolyLine2f			mData;			//!< The 2D PolyLine data
+	std::vector<BucketVec>	mLevels;		//!< The decimation pyramid: level k holds each complete run of 2^(k+1) points
+	bool					mMonotonic;		//!< Flags whether the points' x-values are non-decreasing
+	ci::Rectf				mDrawBounds;	//!< The visible range of the plot
+	ci::Vec2f				mDrawPixelDim;	//!< The size of the plot in pixels (zero if unknown)
+	std::vector<ci::Vec2f>	mDecimated;		//!< The cached decimated vertices
+	bool					mDirty;			//!< Flags whether the decimated vertices need updating
 	
 public:
 	
@@ -78,4 +127,30 @@ public:
 	
 	/** @brief An overloadable draw method */
 	virtual void			draw();
+	
+	/** @brief Flags the decimated vertices for updating when the plot's visible range or pixel size changes */
+	virtual void			setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim);
+	
+	/** @brief Appends the decimated PolyLine as a single line strip */
+	virtual bool			appendStrips(PlotterStripVec& oStrips);
+	
+	/** @brief Appends a point to the PolyLine in amortized constant time */
+	void					appendPoint(const ci::Vec2f& iPoint);
+	
+	/** @brief Returns a const reference to the PolyLine data */
+	const ci::PolyLine2f&	getData() const;
+	
+protected:
+	
+	/** @brief Adds the point at the given index to the decimation pyramid */
+	void					updatePyramid(const size_t& iIndex);
+	
+	/** @brief Recomputes the decimated vertices for the visible range */
+	void					updateDecimated();
+	
+	/** @brief Returns the bucket covering a single point */
+	static Bucket			makeBucket(const ci::Vec2f& iPoint);
+	
+	/** @brief Returns the bucket covering two consecutive buckets */
+	static Bucket			mergeBuckets(const Bucket& iFirst, const Bucket& iSecond);
 };
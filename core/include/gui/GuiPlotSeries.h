@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+
+#include "cinder/gl/Vbo.h"
+
+#include "GuiPlotData.h"
+
+/**
+ * @brief A fixed-capacity, lock-free queue for handing items from exactly one producer thread to exactly one consumer thread
+ */
+template<typename T> class SpscQueue {
+protected:
+	
+	std::vector<T>			mSlots;	//!< The item storage (one slot is always left empty to distinguish full from empty)
+	std::atomic<size_t>		mHead;	//!< The index of the next slot to be written (advanced by the producer)
+	std::atomic<size_t>		mTail;	//!< The index of the next slot to be read (advanced by the consumer)
+	
+public:
+	
+	/** @brief Basic constructor */
+	SpscQueue(const size_t& iCapacity) : mSlots( iCapacity + 1 ), mHead( 0 ), mTail( 0 ) {}
+	
+	/** @brief Pushes an item from the producer thread. Returns false, dropping the item, if the queue is full */
+	bool push(const T& iItem)
+	{
+		size_t tHead = mHead.load( std::memory_order_relaxed );
+		size_t tNext = ( tHead + 1 ) % mSlots.size();
+		if( tNext == mTail.load( std::memory_order_acquire ) ) { return false; }
+		mSlots[ tHead ] = iItem;
+		mHead.store( tNext, std::memory_order_release );
+		return true;
+	}
+	
+	/** @brief Pops an item on the consumer thread. Returns false if the queue is empty */
+	bool pop(T& oItem)
+	{
+		size_t tTail = mTail.load( std::memory_order_relaxed );
+		if( tTail == mHead.load( std::memory_order_acquire ) ) { return false; }
+		oItem = mSlots[ tTail ];
+		mTail.store( ( tTail + 1 ) % mSlots.size(), std::memory_order_release );
+		return true;
+	}
+};
+
+typedef std::shared_ptr<class PlotSeries>	PlotSeriesRef;	//!< A shared pointer to a PlotSeries item
+
+/**
+ * @brief A PlotterData series that keeps the most recent points in a ring buffer for live plotting.
+ * Points may be pushed from one producer thread (such as an evolution thread) through a lock-free queue
+ * and are drained on the drawing thread, where only the newly written points are uploaded to the vertex buffer.
+ */
+class PlotSeries : public PlotterData {
+protected:
+	
+	std::vector<ci::Vec2f>	mPoints;		//!< The ring buffer, with one extra slot mirroring the first so that a wrapped series draws as two strips
+	size_t					mCapacity;		//!< The maximum number of points retained
+	size_t					mHead;			//!< The index of the next point to be written
+	size_t					mSize;			//!< The number of points retained
+	size_t					mPending;		//!< The number of points written since the last upload
+	size_t					mQueueCapacity;	//!< The capacity of the handoff queue
+	SpscQueue<ci::Vec2f>	mQueue;			//!< The handoff queue from the producer thread
+	ci::gl::Vbo				mVbo;			//!< The vertex buffer mirroring the ring buffer
+	
+public:
+	
+	/** @brief Basic constructor */
+	PlotSeries(const size_t& iCapacity = 4096, const size_t& iQueueCapacity = 1024,
+			   const ci::ColorA& iColor = ci::ColorA::white(), const float& iStrokeWeight = 2.0);
+	
+	/** @brief Virtual destructor */
+	virtual ~PlotSeries();
+	
+	/** @brief Returns a clone of this item, holding a copy of the retained points */
+	virtual PlotterData*	clone();
+	
+	/** @brief Drains pending points, uploads new points and draws the series */
+	virtual void			draw();
+	
+	/** @brief Pushes a point from the producer thread. Returns false, dropping the point, if the handoff queue is full */
+	bool					push(const ci::Vec2f& iPoint);
+	
+	/** @brief Appends a point on the drawing thread, overwriting the oldest point once the series is full */
+	void					append(const ci::Vec2f& iPoint);
+	
+	/** @brief Appends the points pushed since the last update and returns their number */
+	size_t					update();
+	
+	/** @brief Returns the number of points retained */
+	const size_t&			getSize() const;
+	
+	/** @brief Returns the maximum number of points retained */
+	const size_t&			getCapacity() const;
+	
+	/** @brief Returns the capacity of the handoff queue */
+	const size_t&			getQueueCapacity() const;
+	
+	/** @brief Returns the point at the given index, counting from the oldest retained point */
+	const ci::Vec2f&		getPoint(const size_t& iIndex) const;
+	
+protected:
+	
+	/** @brief Uploads the points written since the last upload to the vertex buffer */
+	void					upload();
+	
+	/** @brief Uploads the ring buffer slots in [ iBegin, iEnd ) */
+	void					uploadRange(const size_t& iBegin, const size_t& iEnd);
+};
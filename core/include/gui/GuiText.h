@@ -17,8 +17,6 @@
 class GuiText : public GuiBase {
 protected:
 	
-	typedef std::pair<uint16_t,ci::Vec2f>	GlyphPair;		//!< A font glyph data item
-	typedef std::vector<GlyphPair>			GlyphVec;		//!< A vector of font glyph data items
 	typedef GlyphVec::iterator				GlyphVecIter;	//!< An iterator type for a vector of font glyph data items
 	typedef GlyphVec::reverse_iterator		GlyphVecRiter;	//!< A reverse iterator type for a vector of font glyph data items
 	typedef GlyphVec::const_iterator		GlyphVecCiter;	//!< A const iterator type for a vector of font glyph data items
@@ -33,6 +31,7 @@ protected:
 	GlyphVec							mGlyphs;			//!< Stores the text label's glyph placements
 	ci::gl::TextureFontRef				mFontRef;			//!< A reference to the label's font
 	ci::gl::TextureFont::DrawOptions	mFontOptions;		//!< A reference to the label's font options
+	FontSuitcase*						mSuitcaseRef;		//!< A pointer to the font suitcase holding the glyph run cache and batch
 	
 public:
 	
@@ -45,7 +44,7 @@ public:
 	/** @brief An overloadable draw method */
 	virtual void			draw();
 		
-	/** @brief Sets the text label */
+	/** @brief Sets the text label (doing nothing if it is unchanged) */
 	void					setText(const std::string& iText);
 	
 	/** @brief Returns the text label */
@@ -11,6 +11,8 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <list>
+#include <vector>
 
 #include "cinder/app/AppNative.h"
 #include "cinder/Utilities.h"
@@ -115,6 +117,111 @@ public:
 	FontFamilyNode*		getNodeRef(const int& iSize);
 };
 
+typedef std::pair<uint16_t,ci::Vec2f>	GlyphPair;	//!< A font glyph data item
+typedef std::vector<GlyphPair>			GlyphVec;	//!< A vector of font glyph data items
+
+/**
+ * @brief A glyph run shaped from a string, along with its measured size
+ */
+struct GlyphRun {
+	GlyphVec		mGlyphs;	//!< The glyph placements
+	ci::Vec2f		mSize;		//!< The measured size of the string
+};
+
+/**
+ * @brief A least-recently-used cache of glyph runs keyed by font and string.
+ * Each font is assumed to be always shaped with the same draw options (as with the options held by a FontFamilyNode)
+ */
+class GlyphRunCache {
+	
+	typedef std::pair<const ci::gl::TextureFont*,std::string>	GlyphRunKey;		//!< A (font, string) cache key
+	typedef std::pair<GlyphRunKey,GlyphRun>						GlyphRunItem;		//!< A cached glyph run along with its key
+	typedef std::list<GlyphRunItem>								GlyphRunList;		//!< A list of cached glyph runs, ordered from most to least recently used
+	typedef std::map<GlyphRunKey,GlyphRunList::iterator>		GlyphRunMap;		//!< A map type storing <GlyphRunKey,GlyphRunList::iterator> pairs
+	
+private:
+	
+	GlyphRunList	mRuns;		//!< The cached glyph runs, ordered from most to least recently used
+	GlyphRunMap		mLookup;	//!< The position of each cached glyph run in the list
+	size_t			mCapacity;	//!< The maximum number of cached glyph runs
+	
+public:
+	
+	/** @brief Basic constructor */
+	GlyphRunCache(const size_t& iCapacity = 256);
+	
+	/** @brief Destructor */
+	~GlyphRunCache();
+	
+	/** @brief Returns the glyph run of the given string in the given font, shaping it and evicting the least recently used run if it is not cached */
+	const GlyphRun&		getRun(const ci::gl::TextureFontRef& iFont, const std::string& iText, const ci::gl::TextureFont::DrawOptions& iOptions);
+	
+	/** @brief Removes all cached glyph runs */
+	void				clear();
+	
+	/** @brief Sets the maximum number of cached glyph runs */
+	void				setCapacity(const size_t& iCapacity);
+	
+	/** @brief Returns the maximum number of cached glyph runs */
+	const size_t&		getCapacity() const;
+	
+	/** @brief Returns the number of cached glyph runs */
+	size_t				getSize() const;
+	
+private:
+	
+	/** @brief Evicts least recently used glyph runs until the cache is within its capacity */
+	void				evict();
+};
+
+/**
+ * @brief Collects the glyphs of many text labels so that each font is drawn with a single drawGlyphs call.
+ * Collected glyphs are drawn when the batch is flushed or ended, so batched text appears above everything drawn
+ * since the previous flush, including shapes that come later in tree order (a label's own highlight and guides
+ * still appear beneath it). Call flush() at any layer boundary that must cover the text drawn before it.
+ */
+class GlyphBatch {
+	
+	/**
+	 * @brief The glyphs collected for one font
+	 */
+	struct FontBatch {
+		ci::gl::TextureFontRef				mFont;		//!< The font
+		ci::gl::TextureFont::DrawOptions	mOptions;	//!< The font's draw options
+		GlyphVec							mGlyphs;	//!< The collected glyphs, in screen coordinates
+		std::vector<ci::ColorA8u>			mColors;	//!< The color of each collected glyph
+	};
+	
+private:
+	
+	std::vector<FontBatch>	mBatches;	//!< The collected glyphs for each font
+	bool					mActive;	//!< Flags whether glyphs are being collected
+	
+public:
+	
+	/** @brief Basic constructor */
+	GlyphBatch();
+	
+	/** @brief Destructor */
+	~GlyphBatch();
+	
+	/** @brief Starts collecting glyphs */
+	void				begin();
+	
+	/** @brief Draws the collected glyphs (one drawGlyphs call per font) and stops collecting */
+	void				end();
+	
+	/** @brief Draws the collected glyphs (one drawGlyphs call per font) and keeps collecting */
+	void				flush();
+	
+	/** @brief Returns true if glyphs are being collected */
+	const bool&			isActive() const;
+	
+	/** @brief Adds the given glyphs, drawn from the given baseline in the given color */
+	void				addGlyphs(const ci::gl::TextureFontRef& iFont, const ci::gl::TextureFont::DrawOptions& iOptions,
+								  const GlyphVec& iGlyphs, const ci::Vec2f& iBaseline, const ci::ColorA& iColor);
+};
+
 /**
  * @brief A wrapper for a collection of gl::TextureFont families
  */
@@ -128,6 +235,8 @@ public:
 private:
 	
 	FontFamilyMap	mFamilies;	//!< The suitcase's font family map
+	GlyphRunCache	mRunCache;	//!< The glyph runs shaped from the suitcase's fonts
+	GlyphBatch		mBatch;		//!< The batch collecting glyphs drawn in the suitcase's fonts
 	
 public:
 	
@@ -146,4 +255,10 @@ public:
 	
 	/** @brief Returns a reference to the TextureFont with the given family name, size and style */
 	ci::gl::TextureFontRef	getFontRef(const std::string& iFamilyName, const int& iSize, const FontStyle& iStyle);
+	
+	/** @brief Returns a reference to the glyph run cache */
+	GlyphRunCache&			getRunCache();
+	
+	/** @brief Returns a reference to the glyph batch */
+	GlyphBatch&				getBatch();
 };
\ No newline at end of file
@@ -20,7 +20,12 @@ PolynomialData::PolynomialData(const float& iParamIn, const float& iParamOut,
 	mDrawRangeOut( iParamOut ),
 	mDrawFormula( iDrawFormula ),
 	mDrawDeriv( iDrawDeriv ),
-	mDirty( true )
+	mDirty( true ),
+	mDrawBounds( 0.0, 0.0, 0.0, 0.0 ),
+	mDrawPixelDim( 0.0, 0.0 ),
+	mDrawFormulaCount( 0 ),
+	mDrawDerivCount( 0 ),
+	mDrawMeshStale( false )
 {
 	mDrawSamples = ( mDrawRangeOut - mDrawRangeIn ) * 100;
 }
@@ -40,36 +45,157 @@ PlotterData* PolynomialData::clone()
 
 void PolynomialData::draw()
 {
+	// Resample data if it has changed since the last draw:
+	if( mDirty ) {
+		updateSamples();
+	}
+	// Upload samples if they have changed since the last upload:
+	if( mDrawMeshStale ) {
+		updateDrawMesh();
+	}
+	if( !mDrawMesh ) { return; }
 	// Set stroke weight:
 	gl::lineWidth( toPixels( mStrokeWeight ) );
 	// Set stroke color:
 	gl::color( mColor );
-	// Draw data:	
-	if( mDrawFormula ) {
-		glBegin( GL_LINE_STRIP );
-		for(size_t i = 0; i < mDrawSamples; i++) {
-			// Compute current t:
-			float t = lmap<float>( i, 0.0, mDrawSamples - 1.0, mDrawRangeIn, mDrawRangeOut );
-			glVertex2f( t, getValue( t ) );
-		}
-		glEnd();
+	// Draw data:
+	if( mDrawFormula && mDrawFormulaCount > 1 ) {
+		gl::drawArrays( mDrawMesh, 0, mDrawFormulaCount );
 	}
 	// Draw derivative data (with stipple):
-	if( mDrawDeriv ) {
+	if( mDrawDeriv && mDrawDerivCount > 1 ) {
 		glPushAttrib( GL_ENABLE_BIT );
 		glLineStipple( toPixels( 10 ), 0xAAAA );
 		glEnable( GL_LINE_STIPPLE );
-		glBegin( GL_LINE_STRIP );
+		gl::drawArrays( mDrawMesh, mDrawFormulaCount, mDrawDerivCount );
+		glDisable( GL_LINE_STIPPLE );
+		glPopAttrib();
+	}
+}
+
+bool PolynomialData::appendStrips(PlotterStripVec& oStrips)
+{
+	// Resample data if it has changed since the last draw:
+	if( mDirty ) {
+		updateSamples();
+	}
+	// Append formula strip:
+	if( mDrawFormula && mDrawFormulaCount > 1 ) {
+		oStrips.push_back( PlotterStrip( mColor, mStrokeWeight ) );
+		for(size_t i = 0; i < mDrawFormulaCount; i++) {
+			oStrips.back().mVertices.push_back( mDrawPositions[ i ].xy() );
+		}
+	}
+	// Append derivative strip (with stipple):
+	if( mDrawDeriv && mDrawDerivCount > 1 ) {
+		oStrips.push_back( PlotterStrip( mColor, mStrokeWeight, true ) );
+		for(size_t i = mDrawFormulaCount; i < mDrawFormulaCount + mDrawDerivCount; i++) {
+			oStrips.back().mVertices.push_back( mDrawPositions[ i ].xy() );
+		}
+	}
+	return true;
+}
+
+void PolynomialData::setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim)
+{
+	if( iRange.getUpperLeft() != mDrawBounds.getUpperLeft() || iRange.getLowerRight() != mDrawBounds.getLowerRight() || iPixelDim != mDrawPixelDim ) {
+		mDrawBounds   = iRange;
+		mDrawPixelDim = iPixelDim;
+		mDirty        = true;
+		mRevision++;
+	}
+}
+
+void PolynomialData::updateSamples()
+{
+	mDirty         = false;
+	mDrawMeshStale = true;
+	// Sample formula and derivative into consecutive strips:
+	mDrawPositions.clear();
+	if( mDrawPixelDim.x > 0.0 && mDrawPixelDim.y > 0.0 ) {
+		// Sample adaptively to the plot's visible range and resolution:
+		sampleAdaptive( false, mDrawPositions );
+		mDrawFormulaCount = mDrawPositions.size();
+		sampleAdaptive( true, mDrawPositions );
+		mDrawDerivCount = mDrawPositions.size() - mDrawFormulaCount;
+	}
+	else if( mDrawSamples > 1 ) {
+		// Without a known plot size, fall back to uniform sampling:
+		mDrawPositions.resize( mDrawSamples * 2 );
 		for(size_t i = 0; i < mDrawSamples; i++) {
+			// Compute current t:
 			float t = lmap<float>( i, 0.0, mDrawSamples - 1.0, mDrawRangeIn, mDrawRangeOut );
-			glVertex2f( t, getDerivativeValue( t ) );
+			mDrawPositions[ i ]                = Vec3f( t, getValue( t ), 0.0 );
+			mDrawPositions[ i + mDrawSamples ] = Vec3f( t, getDerivativeValue( t ), 0.0 );
 		}
-		glEnd();
-		glDisable( GL_LINE_STIPPLE );
-		glPopAttrib();
+		mDrawFormulaCount = mDrawDerivCount = mDrawSamples;
+	}
+	else {
+		mDrawFormulaCount = mDrawDerivCount = 0;
 	}
 }
 
+void PolynomialData::updateDrawMesh()
+{
+	mDrawMeshStale = false;
+	if( mDrawPositions.empty() ) { return; }
+	// Reallocate mesh if the samples outgrow it (rounding up to limit reallocation as the sample count varies):
+	if( !mDrawMesh || mDrawMesh->getNumVertices() < mDrawPositions.size() ) {
+		size_t tCapacity = 256;
+		while( tCapacity < mDrawPositions.size() ) { tCapacity *= 2; }
+		gl::VboMesh::Layout tLayout;
+		tLayout.setStaticPositions();
+		mDrawMesh = gl::VboMesh::create( tCapacity, 0, tLayout, GL_LINE_STRIP );
+	}
+	// Upload samples:
+	mDrawMesh->bufferPositions( mDrawPositions );
+}
+
+void PolynomialData::sampleAdaptive(const bool& iDerivative, vector<Vec3f>& oPositions) const
+{
+	// Clip the parameter range to the visible range:
+	float tIn  = max( mDrawRangeIn, min( mDrawBounds.x1, mDrawBounds.x2 ) );
+	float tOut = min( mDrawRangeOut, max( mDrawBounds.x1, mDrawBounds.x2 ) );
+	if( tIn >= tOut ) { return; }
+	// Compute pixels per graph unit:
+	Vec2f tPixelScale( mDrawPixelDim.x / fabs( mDrawBounds.getWidth() ), mDrawPixelDim.y / fabs( mDrawBounds.getHeight() ) );
+	if( !isfinite( tPixelScale.x ) || !isfinite( tPixelScale.y ) ) { return; }
+	// Seed with one segment per 16 pixels, so that narrow features are not skipped over by the midpoint test:
+	float  tSpan     = ( tOut - tIn ) * tPixelScale.x;
+	size_t tSegments = (size_t)min( max( ceil( tSpan / 16.0f ), 1.0f ), 256.0f );
+	Vec2f  tPrev( tIn, getSampleValue( iDerivative, tIn ) );
+	oPositions.push_back( Vec3f( tPrev.x, tPrev.y, 0.0 ) );
+	for(size_t i = 1; i <= tSegments; i++) {
+		float t = lmap<float>( i, 0.0, tSegments, tIn, tOut );
+		Vec2f tCurr( t, getSampleValue( iDerivative, t ) );
+		subdivide( iDerivative, tPrev, tCurr, tPixelScale, 0, oPositions );
+		tPrev = tCurr;
+	}
+}
+
+void PolynomialData::subdivide(const bool& iDerivative, const Vec2f& iPtA, const Vec2f& iPtB, const Vec2f& iPixelScale,
+							   const int& iDepth, vector<Vec3f>& oPositions) const
+{
+	// Stop subdividing once a segment is narrower than a pixel:
+	if( iDepth < 16 && ( iPtB.x - iPtA.x ) * iPixelScale.x > 1.0 ) {
+		// Measure the on-screen distance between the curve and the segment at its midpoint:
+		float tMid   = ( iPtA.x + iPtB.x ) * 0.5;
+		Vec2f tPtMid( tMid, getSampleValue( iDerivative, tMid ) );
+		float tError = fabs( tPtMid.y - ( iPtA.y + iPtB.y ) * 0.5 ) * iPixelScale.y;
+		if( !( tError <= 0.5 ) ) {
+			subdivide( iDerivative, iPtA, tPtMid, iPixelScale, iDepth + 1, oPositions );
+			subdivide( iDerivative, tPtMid, iPtB, iPixelScale, iDepth + 1, oPositions );
+			return;
+		}
+	}
+	oPositions.push_back( Vec3f( iPtB.x, iPtB.y, 0.0 ) );
+}
+
+float PolynomialData::getSampleValue(const bool& iDerivative, const float& iParam) const
+{
+	return ( iDerivative ) ? ( getDerivativeValue( iParam ) ) : ( getValue( iParam ) );
+}
+
 void PolynomialData::setDrawParameters(const float& iParamIn, const float &iParamOut,
 									   const bool& iDrawFormula, const bool& iDrawDeriv,
 									   const ci::ColorA& iColor, const float& iStrokeWeight)
@@ -82,16 +208,21 @@ void PolynomialData::setDrawParameters(const float& iParamIn, const float &iPara
 	mStrokeWeight = iStrokeWeight;
 	mDrawSamples  = ( mDrawRangeOut - mDrawRangeIn ) * 100;
 	mDirty        = true;
+	mRevision++;
 }
 
 void PolynomialData::addComponent(const float& iCoeff, const float& iExpon)
 {
 	mComponents.push_back( ComponentPair( iCoeff, iExpon ) );
 	mDirty = true;
+	mRevision++;
 }
 
 PolynomialData::ComponentVec& PolynomialData::getComponents()
 {
+	// The caller may modify the components:
+	mDirty = true;
+	mRevision++;
 	return mComponents;
 }
 
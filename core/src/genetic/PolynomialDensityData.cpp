@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#include "PolynomialDensityData.h"
+
+using namespace std;
+using namespace ci;
+using namespace ci::app;
+
+PolynomialDensityData::PolynomialDensityData(const ci::ColorA& iColor, const float& iResolution) :
+	PlotterData( iColor, 1.0 ),
+	mResolution( iResolution ),
+	mDrawBounds( 0.0, 0.0, 0.0, 0.0 ),
+	mDrawPixelDim( 0.0, 0.0 ),
+	mDirty( true )
+{
+}
+
+PolynomialDensityData::~PolynomialDensityData()
+{
+}
+
+PlotterData* PolynomialDensityData::clone()
+{
+	PolynomialDensityData* tClone = new PolynomialDensityData( mColor, mResolution );
+	tClone->setSnapshot( mSnapshot );
+	return tClone;
+}
+
+void PolynomialDensityData::draw()
+{
+	if( !mSnapshot || mDrawPixelDim.x <= 0.0 || mDrawPixelDim.y <= 0.0 ) { return; }
+	// Update texture, if dirty:
+	if( mDirty ) {
+		updateTexture();
+	}
+	if( !mTexture ) { return; }
+	// Draw texture (its first row holds the bottom of the range):
+	gl::color( ColorA::white() );
+	gl::draw( mTexture, Rectf( mDrawBounds.x1, mDrawBounds.y1, mDrawBounds.x2, mDrawBounds.y2 ) );
+}
+
+void PolynomialDensityData::setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim)
+{
+	if( iRange.getUpperLeft() != mDrawBounds.getUpperLeft() || iRange.getLowerRight() != mDrawBounds.getLowerRight() || iPixelDim != mDrawPixelDim ) {
+		mDrawBounds   = iRange;
+		mDrawPixelDim = iPixelDim;
+		mDirty        = true;
+		mRevision++;
+	}
+}
+
+void PolynomialDensityData::setSnapshot(PopulationSnapshotRef iSnapshot)
+{
+	if( iSnapshot != mSnapshot ) {
+		mSnapshot = iSnapshot;
+		mDirty    = true;
+		mRevision++;
+	}
+}
+
+PopulationSnapshotRef PolynomialDensityData::getSnapshot() const
+{
+	return mSnapshot;
+}
+
+void PolynomialDensityData::setResolution(const float& iResolution)
+{
+	mResolution = iResolution;
+	mDirty      = true;
+	mRevision++;
+}
+
+const float& PolynomialDensityData::getResolution() const
+{
+	return mResolution;
+}
+
+void PolynomialDensityData::updateTexture()
+{
+	mDirty = false;
+	// Compute texture dimension:
+	int   tWidth  = max( (int)( mDrawPixelDim.x * mResolution ), 1 );
+	int   tHeight = max( (int)( mDrawPixelDim.y * mResolution ), 1 );
+	float tRangeW = mDrawBounds.x2 - mDrawBounds.x1;
+	float tRangeH = mDrawBounds.y2 - mDrawBounds.y1;
+	if( tRangeW == 0.0 || tRangeH == 0.0 ) { return; }
+	// Clear density grid:
+	mDensity.assign( tWidth * tHeight, 0 );
+	uint32_t tMaxDensity = 0;
+	// Rasterize each curve column by column:
+	for(size_t g = 0; g < mSnapshot->mGenes.size(); g++) {
+		const PolynomialData::ComponentVec& tGenes = mSnapshot->mGenes[ g ];
+		bool  tHasPrev = false;
+		float tPrevRow = 0.0;
+		for(int x = 0; x < tWidth; x++) {
+			// Compute the curve's row at the column center:
+			float t = mDrawBounds.x1 + ( x + 0.5f ) * tRangeW / tWidth;
+			float tValue = 0.0;
+			for(PolynomialData::ComponentVecCiter it = tGenes.begin(); it != tGenes.end(); it++) {
+				tValue += (*it).first * pow( t, (*it).second );
+			}
+			float tRow = ( tValue - mDrawBounds.y1 ) / tRangeH * tHeight;
+			if( !isfinite( tRow ) ) {
+				tHasPrev = false;
+				continue;
+			}
+			// Fill the span joining the previous column's row, so that steep curves remain connected:
+			float tLo = ( tHasPrev ) ? ( min( tPrevRow, tRow ) ) : ( tRow );
+			float tHi = ( tHasPrev ) ? ( max( tPrevRow, tRow ) ) : ( tRow );
+			tHasPrev = true;
+			tPrevRow = tRow;
+			if( tHi < 0.0 || tLo >= tHeight ) { continue; }
+			int tStart = max( (int)tLo, 0 );
+			int tEnd   = min( (int)tHi, tHeight - 1 );
+			for(int y = tStart; y <= tEnd; y++) {
+				uint32_t& tTexel = mDensity[ y * tWidth + x ];
+				tTexel++;
+				tMaxDensity = max( tMaxDensity, tTexel );
+			}
+		}
+	}
+	// Reallocate surface, if necessary:
+	if( !mSurface || mSurface.getWidth() != tWidth || mSurface.getHeight() != tHeight ) {
+		mSurface = Surface8u( tWidth, tHeight, true );
+	}
+	// Tone-map density logarithmically into the stroke color's alpha:
+	float   tNorm = ( tMaxDensity > 0 ) ? ( 1.0f / log( 1.0f + tMaxDensity ) ) : ( 0.0f );
+	uint8_t tR    = (uint8_t)( constrain( mColor.r, 0.0f, 1.0f ) * 255.0f );
+	uint8_t tG    = (uint8_t)( constrain( mColor.g, 0.0f, 1.0f ) * 255.0f );
+	uint8_t tB    = (uint8_t)( constrain( mColor.b, 0.0f, 1.0f ) * 255.0f );
+	float   tA    = constrain( mColor.a, 0.0f, 1.0f ) * 255.0f;
+	Surface8u::Iter tIter = mSurface.getIter();
+	while( tIter.line() ) {
+		while( tIter.pixel() ) {
+			uint32_t tTexel = mDensity[ tIter.y() * tWidth + tIter.x() ];
+			tIter.r() = tR;
+			tIter.g() = tG;
+			tIter.b() = tB;
+			tIter.a() = (uint8_t)( tA * log( 1.0f + tTexel ) * tNorm );
+		}
+	}
+	// Upload texture, reallocating it if the dimension has changed:
+	if( !mTexture || mTexture.getWidth() != tWidth || mTexture.getHeight() != tHeight ) {
+		gl::Texture::Format tFormat;
+		tFormat.setMinFilter( GL_LINEAR );
+		tFormat.setMagFilter( GL_LINEAR );
+		mTexture = gl::Texture( mSurface, tFormat );
+	}
+	else {
+		mTexture.update( mSurface );
+	}
+}
@@ -12,18 +12,150 @@ using namespace std;
 using namespace ci;
 using namespace ci::app;
 
+static const float kCoeffMin = -10.0;	//!< The lower bound of randomly generated coefficients
+static const float kCoeffMax =  10.0;	//!< The upper bound of randomly generated coefficients
+static const int   kComponents = 5;		//!< The number of components in randomly generated individuals
+
+PolynomialPopulation::Format::Format() :
+	mStagnationWindow( 0 ),
+	mStagnationEpsilon( 0.0 ),
+	mDiversityThreshold( 0.0 ),
+	mStagnationAction( STAGNATION_IGNORE ),
+	mStagnationParam( 0.0 ),
+	mMutationControl( MUTATION_FIXED ),
+	mMutationRateMin( 0.0 ),
+	mMutationRateMax( 1.0 ),
+	mSnapshotInterval( 0 )
+{
+}
+
+PolynomialPopulation::Format& PolynomialPopulation::Format::stagnation(const size_t& iWindow, const float& iEpsilon, const float& iDiversityThreshold)
+{
+	mStagnationWindow   = iWindow;
+	mStagnationEpsilon  = iEpsilon;
+	mDiversityThreshold = iDiversityThreshold;
+	return *this;
+}
+
+PolynomialPopulation::Format& PolynomialPopulation::Format::stagnationAction(const StagnationAction& iAction, const float& iParam)
+{
+	mStagnationAction = iAction;
+	mStagnationParam  = iParam;
+	// Fall back to doubling the mutation rate if the multiplier would not raise it:
+	if( iAction == STAGNATION_MUTATION && iParam <= 1.0 ) {
+		mStagnationParam = 2.0;
+	}
+	return *this;
+}
+
+PolynomialPopulation::Format& PolynomialPopulation::Format::mutationControl(const MutationControl& iControl, const float& iMinRate, const float& iMaxRate)
+{
+	mMutationControl = iControl;
+	mMutationRateMin = min( iMinRate, iMaxRate );
+	mMutationRateMax = max( iMinRate, iMaxRate );
+	return *this;
+}
+
+PolynomialPopulation::Format& PolynomialPopulation::Format::fitnessSeries(PlotSeriesRef iBest, PlotSeriesRef iAverage, PlotSeriesRef iWorst)
+{
+	mBestSeries    = iBest;
+	mAverageSeries = iAverage;
+	mWorstSeries   = iWorst;
+	return *this;
+}
+
+PolynomialPopulation::Format& PolynomialPopulation::Format::snapshotInterval(const size_t& iInterval)
+{
+	mSnapshotInterval = iInterval;
+	return *this;
+}
+
+const size_t& PolynomialPopulation::Format::getStagnationWindow() const
+{
+	return mStagnationWindow;
+}
+
+const float& PolynomialPopulation::Format::getStagnationEpsilon() const
+{
+	return mStagnationEpsilon;
+}
+
+const float& PolynomialPopulation::Format::getDiversityThreshold() const
+{
+	return mDiversityThreshold;
+}
+
+const StagnationAction& PolynomialPopulation::Format::getStagnationAction() const
+{
+	return mStagnationAction;
+}
+
+const float& PolynomialPopulation::Format::getStagnationParam() const
+{
+	return mStagnationParam;
+}
+
+const MutationControl& PolynomialPopulation::Format::getMutationControl() const
+{
+	return mMutationControl;
+}
+
+const float& PolynomialPopulation::Format::getMutationRateMin() const
+{
+	return mMutationRateMin;
+}
+
+const float& PolynomialPopulation::Format::getMutationRateMax() const
+{
+	return mMutationRateMax;
+}
+
+PlotSeriesRef PolynomialPopulation::Format::getBestSeries() const
+{
+	return mBestSeries;
+}
+
+PlotSeriesRef PolynomialPopulation::Format::getAverageSeries() const
+{
+	return mAverageSeries;
+}
+
+PlotSeriesRef PolynomialPopulation::Format::getWorstSeries() const
+{
+	return mWorstSeries;
+}
+
+const size_t& PolynomialPopulation::Format::getSnapshotInterval() const
+{
+	return mSnapshotInterval;
+}
+
 PolynomialPopulation::PolynomialPopulation(const AssertionGroup& iAssertionGroup, const size_t& iPopulationSize,
-					 const size_t& iMaxGenerationCount, const float& iMutationRate, const float& iPerfectScore) :
+					 const size_t& iMaxGenerationCount, const float& iMutationRate, const float& iPerfectScore,
+					 const Format& iFormat) :
 	mPopulationSize( iPopulationSize ),
 	mAssertionGroup( iAssertionGroup ),
 	mMutationRate( iMutationRate ),
+	mMutationRateBase( iMutationRate ),
 	mGenerationMax( iMaxGenerationCount ),
 	mPerfectThreshold( iPerfectScore ),
+	mFormat( iFormat ),
+	mStagnantGenerations( 0 ),
+	mBestScoreRecord( -1e12 ),
+	mAvgScoreRecord( -1e12 ),
+	mStagnated( false ),
+	mDiversity( 1.0 ),
+	mIndividualRates( iPopulationSize, iMutationRate ),
 	mGenerationIter( 0 ),
 	mRunning( true ),
 	mBuffer( 100 ),
 	mPopulation( NULL )
 {
+	// Keep the initial rate within the controlled range:
+	if( mFormat.getMutationControl() != MUTATION_FIXED ) {
+		mMutationRate = min( max( mMutationRate, mFormat.getMutationRateMin() ), mFormat.getMutationRateMax() );
+		mIndividualRates.assign( mPopulationSize, mMutationRate );
+	}
 	mThread = make_shared<thread>( bind( &PolynomialPopulation::computeEvolution, this ) );
 }
 
@@ -53,6 +185,24 @@ PolynomialDataRef PolynomialPopulation::getUpdate()
 	return tResult;
 }
 
+float PolynomialPopulation::getDiversity()
+{
+	lock_guard<mutex> tLock( mStatsMutex );
+	return mDiversity;
+}
+
+vector<float> PolynomialPopulation::getCoefficientDeviations()
+{
+	lock_guard<mutex> tLock( mStatsMutex );
+	return mCoeffDeviations;
+}
+
+PopulationSnapshotRef PolynomialPopulation::getSnapshot()
+{
+	lock_guard<mutex> tLock( mSnapshotMutex );
+	return mSnapshot;
+}
+
 void PolynomialPopulation::computeEvolution()
 {
 	ThreadSetup threadSetup;
@@ -68,9 +218,13 @@ void PolynomialPopulation::computeEvolution()
 		size_t tBestIdx    = 0;
 		float  tBestScore  = -1e12;
 		float  tWorstScore = 1e12;
+		float  tSum        = 0.0;
+		float  tSqSum      = 0.0;
 		// Perform scoring:
 		for(size_t i = 0; i < mPopulationSize; i++) {
 			tScores[ i ] = fitnessFunction( mPopulation[ i ] );
+			tSum   += tScores[ i ];
+			tSqSum += tScores[ i ] * tScores[ i ];
 			if( tScores[ i ] > tBestScore ) {
 				tBestScore = tScores[ i ];
 				tBestIdx   = i;
@@ -79,6 +233,18 @@ void PolynomialPopulation::computeEvolution()
 				tWorstScore = tScores[ i ];
 			}
 		}
+		// Publish snapshot, if requested for this generation:
+		if( mFormat.getSnapshotInterval() > 0 && mGenerationIter % mFormat.getSnapshotInterval() == 0 ) {
+			publishSnapshot( tScores );
+		}
+		// Push score statistics to any attached series (dropping them if the drawing thread has fallen behind):
+		if( mFormat.getBestSeries() )    { mFormat.getBestSeries()->push( Vec2f( mGenerationIter, tBestScore ) ); }
+		if( mFormat.getAverageSeries() ) { mFormat.getAverageSeries()->push( Vec2f( mGenerationIter, tSum / (float)mPopulationSize ) ); }
+		if( mFormat.getWorstSeries() )   { mFormat.getWorstSeries()->push( Vec2f( mGenerationIter, tWorstScore ) ); }
+		// Update diversity metrics:
+		updateDiversity();
+		// Update mutation rate:
+		updateMutationRate( tScores );
 		// Print the best individual:
 		printFunction( mPopulation[ tBestIdx ] );
 		// Push a clone of the best individual into buffer:
@@ -87,6 +253,10 @@ void PolynomialPopulation::computeEvolution()
 		if( tBestScore >= mPerfectThreshold ) {
 			mRunning = false;
 		}
+		// Check whether the population has stagnated:
+		else if( updateStagnation( tBestScore, tSum, tSqSum ) && mFormat.getStagnationAction() == STAGNATION_STOP ) {
+			mRunning = false;
+		}
 		// Handle mating:
 		else {
 			// Normalize scores:
@@ -97,6 +267,8 @@ void PolynomialPopulation::computeEvolution()
 			if( tBestScore == tWorstScore ) {
 				tBestScore += 0.1;
 			}
+			// Keep raw scores for the 1/5th success rule:
+			vector<float> tRawScores( tScores, tScores + mPopulationSize );
 			// Normalize scores:
 			for(size_t i = 0; i < mPopulationSize; i++) {
 				tScores[ i ] = tNormMin + ( tNormMax - tNormMin ) * ( ( tScores[i] - tWorstScore ) / ( tBestScore - tWorstScore ) );
@@ -104,6 +276,8 @@ void PolynomialPopulation::computeEvolution()
 			}
 			// Initialize new population:
 			PolynomialDataRef* tPopulation = new PolynomialDataRef[ mPopulationSize ];
+			vector<float> tParentScores( mPopulationSize );
+			vector<float> tRates( mPopulationSize );
 			// Create a new population:
 			for(int i = 0; i < mPopulationSize; i++) {
 				// Choose mating pair:
@@ -115,24 +289,178 @@ void PolynomialPopulation::computeEvolution()
 				while( tRandB > 0.0 ) { tRandB -= tScores[ tIdxB++ ]; }
 				// Apply crossover function:
 				tPopulation[ i ] = crossoverFunction( mPopulation[ tIdxA - 1 ], mPopulation[ tIdxB - 1 ] );
-				// Apply mutation function:
-				mutationFunction( tPopulation[ i ], mMutationRate );
+				tParentScores[ i ] = max( tRawScores[ tIdxA - 1 ], tRawScores[ tIdxB - 1 ] );
+				// Apply mutation function (at the child's own rate, if self-adaptive):
+				if( mFormat.getMutationControl() == MUTATION_SELF_ADAPTIVE ) {
+					tRates[ i ] = inheritMutationRate( mIndividualRates[ tIdxA - 1 ], mIndividualRates[ tIdxB - 1 ] );
+					mutationFunction( tPopulation[ i ], tRates[ i ] );
+				}
+				else {
+					tRates[ i ] = mMutationRate;
+					mutationFunction( tPopulation[ i ], mMutationRate );
+				}
 			}
+			mParentScores.swap( tParentScores );
+			mIndividualRates.swap( tRates );
 			// Delete previous population:
 			delete [] mPopulation;
 			// Set new population:
 			mPopulation = tPopulation;
+			// Replace a portion of the population with immigrants, if stagnant:
+			if( mStagnated && mFormat.getStagnationAction() == STAGNATION_IMMIGRANTS ) {
+				size_t tCount = min( (size_t)( mFormat.getStagnationParam() * mPopulationSize ), mPopulationSize );
+				for(size_t i = 0; i < tCount; i++) {
+					mPopulation[ i ] = initializationFunction();
+				}
+			}
 			// Advance generation iter:
 			mGenerationIter++;
 		}
 	}
 }
 
+bool PolynomialPopulation::updateStagnation(const float& iBestScore, const float& iScoreSum, const float& iScoreSqSum)
+{
+	mStagnated = false;
+	if( mFormat.getStagnationWindow() == 0 ) { return false; }
+	// Compute score statistics:
+	float tAvgScore = iScoreSum / (float)mPopulationSize;
+	float tVariance = max( iScoreSqSum / (float)mPopulationSize - tAvgScore * tAvgScore, 0.0f );
+	// Check for improvement over the best and average records:
+	bool tImproved = false;
+	if( iBestScore > mBestScoreRecord + mFormat.getStagnationEpsilon() ) {
+		mBestScoreRecord = iBestScore;
+		tImproved = true;
+	}
+	if( tAvgScore > mAvgScoreRecord + mFormat.getStagnationEpsilon() ) {
+		mAvgScoreRecord = tAvgScore;
+		tImproved = true;
+	}
+	// Update stagnant generation count:
+	if( tImproved ) {
+		mStagnantGenerations = 0;
+		if( mFormat.getMutationControl() == MUTATION_FIXED ) {
+			mMutationRate = mMutationRateBase;
+		}
+	}
+	else {
+		mStagnantGenerations++;
+	}
+	// Check for stagnation or diversity collapse:
+	if( mStagnantGenerations >= mFormat.getStagnationWindow() || sqrt( tVariance ) < mFormat.getDiversityThreshold() ) {
+		mStagnated = true;
+		mStagnantGenerations = 0;
+		// Raise mutation rate, if applicable:
+		if( mFormat.getStagnationAction() == STAGNATION_MUTATION ) {
+			mMutationRate = min( mMutationRate * mFormat.getStagnationParam(), 1.0f );
+		}
+	}
+	return mStagnated;
+}
+
+void PolynomialPopulation::updateMutationRate(const float* iScores)
+{
+	float tMin = mFormat.getMutationRateMin();
+	float tMax = mFormat.getMutationRateMax();
+	switch( mFormat.getMutationControl() ) {
+		case MUTATION_ONE_FIFTH : {
+			if( mParentScores.size() != mPopulationSize ) { break; }
+			// Count children that outscored their best parent:
+			size_t tSuccesses = 0;
+			for(size_t i = 0; i < mPopulationSize; i++) {
+				if( iScores[ i ] > mParentScores[ i ] ) { tSuccesses++; }
+			}
+			// Apply the 1/5th success rule:
+			float tFactor = ( tSuccesses * 5 > mPopulationSize ) ? ( 1.0 / 0.82 ) : ( 0.82 );
+			mMutationRate = min( max( mMutationRate * tFactor, tMin ), tMax );
+			break;
+		}
+		case MUTATION_DIVERSITY : {
+			mMutationRate = tMin + ( tMax - tMin ) * ( 1.0f - min( getDiversity(), 1.0f ) );
+			break;
+		}
+		case MUTATION_SELF_ADAPTIVE : {
+			// Report the mean individual rate:
+			float tSum = 0.0;
+			for(size_t i = 0; i < mIndividualRates.size(); i++) {
+				tSum += mIndividualRates[ i ];
+			}
+			if( !mIndividualRates.empty() ) {
+				mMutationRate = tSum / (float)mIndividualRates.size();
+			}
+			break;
+		}
+		default : { break; }
+	}
+}
+
+float PolynomialPopulation::inheritMutationRate(const float& iRateA, const float& iRateB)
+{
+	// Geometric mean of the parents' rates, perturbed log-normally:
+	float tTau  = 1.0 / sqrt( (float)kComponents );
+	float tRate = sqrt( iRateA * iRateB ) * exp( tTau * randGaussian() );
+	return min( max( tRate, mFormat.getMutationRateMin() ), mFormat.getMutationRateMax() );
+}
+
+void PolynomialPopulation::publishSnapshot(const float* iScores)
+{
+	// Copy the population outside of the lock:
+	shared_ptr<PopulationSnapshot> tSnapshot( new PopulationSnapshot() );
+	tSnapshot->mGeneration = mGenerationIter;
+	tSnapshot->mGenes.resize( mPopulationSize );
+	tSnapshot->mScores.assign( iScores, iScores + mPopulationSize );
+	for(size_t i = 0; i < mPopulationSize; i++) {
+		const PolynomialData& tData = *mPopulation[ i ];
+		tSnapshot->mGenes[ i ] = tData.getComponents();
+	}
+	// Swap in the new snapshot:
+	lock_guard<mutex> tLock( mSnapshotMutex );
+	mSnapshot = tSnapshot;
+}
+
+void PolynomialPopulation::updateDiversity()
+{
+	// Accumulate per-coefficient sums:
+	vector<double> tSum;
+	vector<double> tSqSum;
+	vector<size_t> tCount;
+	for(size_t i = 0; i < mPopulationSize; i++) {
+		const PolynomialData& tData = *mPopulation[ i ];
+		const PolynomialData::ComponentVec& tGenes = tData.getComponents();
+		if( tGenes.size() > tSum.size() ) {
+			tSum.resize( tGenes.size(), 0.0 );
+			tSqSum.resize( tGenes.size(), 0.0 );
+			tCount.resize( tGenes.size(), 0 );
+		}
+		for(size_t j = 0; j < tGenes.size(); j++) {
+			tSum[ j ]   += tGenes[ j ].first;
+			tSqSum[ j ] += tGenes[ j ].first * tGenes[ j ].first;
+			tCount[ j ]++;
+		}
+	}
+	// Compute deviations, relative to that of uniformly random coefficients:
+	vector<float> tDeviations( tSum.size(), 0.0 );
+	float tRandomDeviation = ( kCoeffMax - kCoeffMin ) / sqrt( 12.0f );
+	float tDiversity = 0.0;
+	for(size_t j = 0; j < tSum.size(); j++) {
+		double tMean = tSum[ j ] / (double)tCount[ j ];
+		tDeviations[ j ] = (float)sqrt( max( tSqSum[ j ] / (double)tCount[ j ] - tMean * tMean, 0.0 ) );
+		tDiversity += tDeviations[ j ] / tRandomDeviation;
+	}
+	if( !tDeviations.empty() ) {
+		tDiversity /= (float)tDeviations.size();
+	}
+	// Publish metrics:
+	lock_guard<mutex> tLock( mStatsMutex );
+	mCoeffDeviations = tDeviations;
+	mDiversity = tDiversity;
+}
+
 PolynomialDataRef PolynomialPopulation::initializationFunction()
 {
 	PolynomialDataRef tNew = PolynomialDataRef( new PolynomialData() );
-	for(int i = 0; i < 5; i++) {
-		tNew->addComponent( randFloat( -10.0, 10.0 ), (float)i );
+	for(int i = 0; i < kComponents; i++) {
+		tNew->addComponent( randFloat( kCoeffMin, kCoeffMax ), (float)i );
 	}
 	return tNew;
 }
@@ -171,7 +499,7 @@ void PolynomialPopulation::mutationFunction(PolynomialDataRef ioGenes, const flo
 	PolynomialData::ComponentVec& tGenes = ioGenes->getComponents();
 	if( randFloat( 1.0 ) <= iMutationRate ) {
 		size_t tIdx = randInt( 0, tGenes.size() );
-		tGenes[ tIdx ].first = randFloat( -10.0, 10.0 );
+		tGenes[ tIdx ].first = randFloat( kCoeffMin, kCoeffMax );
 	}
 }
 
@@ -19,7 +19,24 @@ GuiBase::GuiBase() :
 	mFlowW( GuiFlow::UI_FIXED ),
 	mFlowH( GuiFlow::UI_FIXED ),
 	mVisible( true ),
-	mParent( NULL )
+	mParent( NULL ),
+	mLayoutPosition( Vec2f::zero() ),
+	mLayoutLocalPosition( Vec2f::zero() ),
+	mLayoutDimension( Vec2f::zero() ),
+	mLayoutWindowSize( Vec2f::zero() ),
+	mLayoutDirty( true ),
+	mLayoutBounds( 0.0, 0.0, 0.0, 0.0 ),
+	mBoundsDirty( true ),
+	mClipChildren( false ),
+	mDrawClip( 0.0, 0.0, 0.0, 0.0 ),
+	mDrawClipped( false ),
+	mHitIndexEnabled( false ),
+	mHitIndexDirty( true ),
+	mHitCellSize( 64.0 ),
+	mHitCols( 0 ),
+	mHitRows( 0 ),
+	mHitOrder( 0 ),
+	mHitHandled( false )
 {
 }
 
@@ -59,13 +76,36 @@ bool GuiBase::getVisibility() const
 void GuiBase::deepDraw()
 {
 	if( getVisibility() ) {
-		// Handle self:
-		draw();
-		// Handle children:
-		for(GuiBaseDequeCiter it = mChildren.begin(); it != mChildren.end(); it++) {
-			(*it)->deepDraw();
+		validateLayout();
+		deepDrawVisible( Rectf( 0.0, 0.0, app::getWindowWidth(), app::getWindowHeight() ), false );
+	}
+}
+
+void GuiBase::deepDrawVisible(const Rectf& iClip, const bool& iClipped)
+{
+	// Skip subtrees outside the clip rect:
+	if( !getBounds().intersects( iClip ) ) { return; }
+	mDrawClip    = iClip;
+	mDrawClipped = iClipped;
+	// Handle self:
+	draw();
+	if( mChildren.empty() ) { return; }
+	// Clip children to own rect, if necessary:
+	Rectf tClip = iClip;
+	if( mClipChildren ) {
+		tClip = getRect().getClipBy( iClip );
+		if( tClip.getWidth() <= 0.0 || tClip.getHeight() <= 0.0 ) { return; }
+		beginClip( getRect() );
+	}
+	// Handle visible children:
+	for(GuiBaseDequeCiter it = mChildren.begin(); it != mChildren.end(); it++) {
+		if( (*it)->mVisible ) {
+			(*it)->deepDrawVisible( tClip, iClipped || mClipChildren );
 		}
 	}
+	if( mClipChildren ) {
+		endClip();
+	}
 }
 
 void GuiBase::draw()
@@ -77,6 +117,14 @@ bool GuiBase::deepMouseMove(ci::app::MouseEvent iEvent)
 {
 	bool tHandled = false;
 	if( getVisibility() ) {
+		validateLayout();
+		// Handle indexed nodes:
+		if( mHitIndexEnabled ) {
+			GuiBaseVec tHits;
+			tHandled = dispatchIndexed( iEvent, &GuiBase::mouseMove, mHitHover, &tHits );
+			mHitHover = tHits;
+			return tHandled;
+		}
 		// Handle children:
 		for(GuiBaseDequeRiter it = mChildren.rbegin(); it != mChildren.rend(); it++) {
 			if( (*it)->deepMouseMove( iEvent ) ) {
@@ -95,6 +143,14 @@ bool GuiBase::deepMouseDown(ci::app::MouseEvent iEvent)
 {
 	bool tHandled = false;
 	if( getVisibility() ) {
+		validateLayout();
+		// Handle indexed nodes:
+		if( mHitIndexEnabled ) {
+			GuiBaseVec tHits;
+			tHandled = dispatchIndexed( iEvent, &GuiBase::mouseDown, GuiBaseVec(), &tHits );
+			mHitCapture = tHits;
+			return tHandled;
+		}
 		// Handle children:
 		for(GuiBaseDequeRiter it = mChildren.rbegin(); it != mChildren.rend(); it++) {
 			if( (*it)->deepMouseDown( iEvent ) ) {
@@ -113,6 +169,14 @@ bool GuiBase::deepMouseDrag(ci::app::MouseEvent iEvent)
 {
 	bool tHandled = false;
 	if( getVisibility() ) {
+		validateLayout();
+		// Handle indexed nodes:
+		if( mHitIndexEnabled ) {
+			GuiBaseVec tHits;
+			tHandled = dispatchIndexed( iEvent, &GuiBase::mouseDrag, mHitCapture, &tHits );
+			mHitHover = tHits;
+			return tHandled;
+		}
 		// Handle children:
 		for(GuiBaseDequeRiter it = mChildren.rbegin(); it != mChildren.rend(); it++) {
 			if( (*it)->deepMouseDrag( iEvent ) ) {
@@ -131,6 +195,13 @@ bool GuiBase::deepMouseUp(ci::app::MouseEvent iEvent)
 {
 	bool tHandled = false;
 	if( getVisibility() ) {
+		validateLayout();
+		// Handle indexed nodes:
+		if( mHitIndexEnabled ) {
+			tHandled = dispatchIndexed( iEvent, &GuiBase::mouseUp, mHitCapture, NULL );
+			mHitCapture.clear();
+			return tHandled;
+		}
 		// Handle children:
 		for(GuiBaseDequeRiter it = mChildren.rbegin(); it != mChildren.rend(); it++) {
 			if( (*it)->deepMouseUp( iEvent ) ) {
@@ -224,6 +295,11 @@ GuiBase* GuiBase::getParent() const
 void GuiBase::setParent(GuiBase* iParent)
 {
 	mParent = iParent;
+	invalidateLayout();
+	// Flag the hit indices of the new ancestors for rebuilding:
+	for(GuiBase* tNode = mParent; tNode != NULL; tNode = tNode->mParent) {
+		tNode->mHitIndexDirty = true;
+	}
 }
 
 bool GuiBase::hasChildren() const
@@ -252,6 +328,7 @@ void GuiBase::setPosition(const Vec2f& iPosition)
 	mPosition = iPosition;
 	mFlowX = GuiFlow::UI_FIXED;
 	mFlowY = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setPosition(const float& iPositionX, const float& iPositionY)
@@ -259,18 +336,21 @@ void GuiBase::setPosition(const float& iPositionX, const float& iPositionY)
 	mPosition = Vec2f( iPositionX, iPositionY );
 	mFlowX = GuiFlow::UI_FIXED;
 	mFlowY = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setPositionX(const float& iPositionX)
 {
 	mPosition.x = iPositionX;
 	mFlowX = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setPositionY(const float& iPositionY)
 {
 	mPosition.y = iPositionY;
 	mFlowY = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativePosition(const ci::Vec2f& iPosition)
@@ -278,6 +358,7 @@ void GuiBase::setRelativePosition(const ci::Vec2f& iPosition)
 	mPosition = iPosition;
 	mFlowX = GuiFlow::UI_RELATIVE;
 	mFlowY = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativePosition(const float& iPositionX, const float& iPositionY)
@@ -285,39 +366,33 @@ void GuiBase::setRelativePosition(const float& iPositionX, const float& iPositio
 	mPosition  = Vec2f( iPositionX, iPositionY );
 	mFlowX = GuiFlow::UI_RELATIVE;
 	mFlowY = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativePositionX(const float& iPositionX)
 {
 	mPosition.x = iPositionX;
 	mFlowX = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativePositionY(const float& iPositionY)
 {
 	mPosition.y = iPositionY;
 	mFlowY = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 Vec2f GuiBase::getPosition() const
 {
-	return getLocalPosition() + ( mParent ? mParent->getPosition() : Vec2f::zero() );
+	if( mLayoutDirty ) { updateLayout(); }
+	return mLayoutPosition;
 }
 
 Vec2f GuiBase::getLocalPosition() const
 {
-	Vec2f tOut = mPosition;
-	if( mFlowX == GuiFlow::UI_RELATIVE ) {
-		float tPar  = ( mParent ? mParent->getDimensionX() : app::getWindowWidth() );
-		float tDim  = ( ( mFlowW == GuiFlow::UI_RELATIVE ) ? ( mDimension.x * tPar ) : ( mDimension.x ) );
-		tOut.x = mPosition.x * ( tPar - tDim );
-	}
-	if( mFlowY == GuiFlow::UI_RELATIVE ) {
-		float tPar  = ( mParent ? mParent->getDimensionY() : app::getWindowHeight() );
-		float tDim  = ( ( mFlowH == GuiFlow::UI_RELATIVE ) ? ( mDimension.y * tPar ) : ( mDimension.y ) );
-		tOut.y = mPosition.y * ( tPar - tDim );
-	}
-	return tOut;
+	if( mLayoutDirty ) { updateLayout(); }
+	return mLayoutLocalPosition;
 }
 
 void GuiBase::setDimension(const Vec2f& iDimension)
@@ -325,6 +400,7 @@ void GuiBase::setDimension(const Vec2f& iDimension)
 	mDimension = iDimension;
 	mFlowW = GuiFlow::UI_FIXED;
 	mFlowH = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setDimension(const float& iDimensionX, const float& iDimensionY)
@@ -332,18 +408,21 @@ void GuiBase::setDimension(const float& iDimensionX, const float& iDimensionY)
 	mDimension = Vec2f( iDimensionX, iDimensionY );
 	mFlowW = GuiFlow::UI_FIXED;
 	mFlowH = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setDimensionX(const float& iDimensionX)
 {
 	mDimension.x = iDimensionX;
 	mFlowW = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setDimensionY(const float& iDimensionY)
 {
 	mDimension.y = iDimensionY;
 	mFlowH = GuiFlow::UI_FIXED;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativeDimension(const ci::Vec2f& iDimension)
@@ -351,6 +430,7 @@ void GuiBase::setRelativeDimension(const ci::Vec2f& iDimension)
 	mDimension = iDimension;
 	mFlowW = GuiFlow::UI_RELATIVE;
 	mFlowH = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativeDimension(const float& iDimensionX, const float& iDimensionY)
@@ -358,31 +438,310 @@ void GuiBase::setRelativeDimension(const float& iDimensionX, const float& iDimen
 	mDimension = Vec2f( iDimensionX, iDimensionY );
 	mFlowW = GuiFlow::UI_RELATIVE;
 	mFlowH = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativeDimensionX(const float& iDimensionX)
 {
 	mDimension.x = iDimensionX;
 	mFlowW = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 void GuiBase::setRelativeDimensionY(const float& iDimensionY)
 {
 	mDimension.y = iDimensionY;
 	mFlowH = GuiFlow::UI_RELATIVE;
+	invalidateLayout();
 }
 
 Vec2f GuiBase::getDimension() const
 {
-	return Vec2f( getDimensionX(), getDimensionY() );
+	if( mLayoutDirty ) { updateLayout(); }
+	return mLayoutDimension;
 }
 
 float GuiBase::getDimensionX() const
 {
-	return ( ( mFlowW == GuiFlow::UI_RELATIVE ) ? ( mDimension.x * ( mParent ? mParent->getDimensionX() : app::getWindowWidth() ) ) : ( mDimension.x ) );
+	return getDimension().x;
 }
 
 float GuiBase::getDimensionY() const
 {
-	return ( ( mFlowH == GuiFlow::UI_RELATIVE ) ? ( mDimension.y * ( mParent ? mParent->getDimensionY() : app::getWindowHeight() ) ) : ( mDimension.y ) );
+	return getDimension().y;
+}
+
+Rectf GuiBase::getRect() const
+{
+	return Rectf( getPosition(), getPosition() + getDimension() );
+}
+
+Rectf GuiBase::getBounds() const
+{
+	if( mBoundsDirty ) {
+		mLayoutBounds = getRect();
+		for(GuiBaseDequeCiter it = mChildren.begin(); it != mChildren.end(); it++) {
+			mLayoutBounds.include( (*it)->getBounds() );
+		}
+		mBoundsDirty = false;
+	}
+	return mLayoutBounds;
+}
+
+void GuiBase::invalidateLayout()
+{
+	// Flag the bounds of enclosing nodes and queue this node for re-indexing by their hit indices:
+	for(GuiBase* tNode = mParent; tNode != NULL; tNode = tNode->mParent) {
+		tNode->mBoundsDirty = true;
+		if( tNode->mHitIndexEnabled && !tNode->mHitIndexDirty ) {
+			tNode->mHitMoved.push_back( this );
+			// Fall back to a rebuild if more nodes have moved than the index holds:
+			if( tNode->mHitMoved.size() > tNode->mHitEntries.size() ) {
+				tNode->mHitIndexDirty = true;
+				tNode->mHitMoved.clear();
+			}
+		}
+	}
+	// Flag this node and its descendants:
+	invalidateSubtreeLayout();
+}
+
+void GuiBase::invalidateSubtreeLayout()
+{
+	mBoundsDirty   = true;
+	mHitIndexDirty = true;
+	// A dirty node's descendants are already dirty:
+	if( mLayoutDirty ) { return; }
+	mLayoutDirty = true;
+	for(GuiBaseDequeCiter it = mChildren.begin(); it != mChildren.end(); it++) {
+		(*it)->invalidateSubtreeLayout();
+	}
+}
+
+void GuiBase::setClipChildren(const bool& iClipChildren)
+{
+	mClipChildren = iClipChildren;
+}
+
+const bool& GuiBase::getClipChildren() const
+{
+	return mClipChildren;
+}
+
+void GuiBase::setHitIndexEnabled(const bool& iEnabled)
+{
+	mHitIndexEnabled = iEnabled;
+	mHitIndexDirty   = true;
+	mHitHover.clear();
+	mHitCapture.clear();
+	mHitMoved.clear();
+}
+
+const bool& GuiBase::getHitIndexEnabled() const
+{
+	return mHitIndexEnabled;
+}
+
+void GuiBase::setHitCellSize(const float& iCellSize)
+{
+	mHitCellSize   = max( iCellSize, 1.0f );
+	mHitIndexDirty = true;
+}
+
+const float& GuiBase::getHitCellSize() const
+{
+	return mHitCellSize;
+}
+
+void GuiBase::validateLayout()
+{
+	if( mParent ) { return; }
+	Vec2f tWindowSize = Vec2f( app::getWindowWidth(), app::getWindowHeight() );
+	if( tWindowSize != mLayoutWindowSize ) {
+		invalidateLayout();
+	}
+}
+
+void GuiBase::updateLayout() const
+{
+	// Gather parent span (the parent's layout is updated first, if dirty):
+	Vec2f tParPos = Vec2f::zero();
+	Vec2f tParDim;
+	if( mParent ) {
+		tParPos = mParent->getPosition();
+		tParDim = mParent->getDimension();
+	}
+	else {
+		tParDim = Vec2f( app::getWindowWidth(), app::getWindowHeight() );
+		mLayoutWindowSize = tParDim;
+	}
+	// Compute dimension:
+	mLayoutDimension.x = ( ( mFlowW == GuiFlow::UI_RELATIVE ) ? ( mDimension.x * tParDim.x ) : ( mDimension.x ) );
+	mLayoutDimension.y = ( ( mFlowH == GuiFlow::UI_RELATIVE ) ? ( mDimension.y * tParDim.y ) : ( mDimension.y ) );
+	// Compute position:
+	mLayoutLocalPosition.x = ( ( mFlowX == GuiFlow::UI_RELATIVE ) ? ( mPosition.x * ( tParDim.x - mLayoutDimension.x ) ) : ( mPosition.x ) );
+	mLayoutLocalPosition.y = ( ( mFlowY == GuiFlow::UI_RELATIVE ) ? ( mPosition.y * ( tParDim.y - mLayoutDimension.y ) ) : ( mPosition.y ) );
+	mLayoutPosition = tParPos + mLayoutLocalPosition;
+	mLayoutDirty    = false;
+}
+
+void GuiBase::beginClip(const Rectf& iRect) const
+{
+	glEnable( GL_SCISSOR_TEST );
+	applyScissor( ( mDrawClipped ) ? ( iRect.getClipBy( mDrawClip ) ) : ( iRect ) );
+}
+
+void GuiBase::endClip() const
+{
+	if( mDrawClipped ) {
+		applyScissor( mDrawClip );
+	}
+	else {
+		glDisable( GL_SCISSOR_TEST );
+	}
+}
+
+void GuiBase::applyScissor(const Rectf& iRect) const
+{
+	// Convert to pixels, with the origin at the bottom of the window:
+	float tWindowH = app::getWindowHeight();
+	glScissor( app::toPixels( iRect.x1 ), app::toPixels( tWindowH - iRect.y2 ), app::toPixels( max( iRect.getWidth(), 0.0f ) ), app::toPixels( max( iRect.getHeight(), 0.0f ) ) );
+}
+
+void GuiBase::updateHitIndex()
+{
+	// Gather nodes and their screen rects:
+	mHitEntries.clear();
+	mHitMoved.clear();
+	appendHitEntries( mHitEntries );
+	// Size grid to cover the window (edge cells also cover the area beyond it):
+	mHitCols = max( (int)ceil( app::getWindowWidth() / mHitCellSize ), 1 );
+	mHitRows = max( (int)ceil( app::getWindowHeight() / mHitCellSize ), 1 );
+	mHitCells.assign( mHitCols * mHitRows, vector<size_t>() );
+	// Add each entry to the cells overlapping its rect (in dispatch order):
+	for(size_t i = 0; i < mHitEntries.size(); i++) {
+		updateHitCells( i, true );
+	}
+	mHitIndexDirty = false;
+}
+
+void GuiBase::validateHitIndex()
+{
+	// Rebuild index, if dirty or resized:
+	int tCols = max( (int)ceil( app::getWindowWidth() / mHitCellSize ), 1 );
+	int tRows = max( (int)ceil( app::getWindowHeight() / mHitCellSize ), 1 );
+	if( mHitIndexDirty || tCols != mHitCols || tRows != mHitRows ) {
+		updateHitIndex();
+		return;
+	}
+	// Re-index moved nodes, rebuilding if one is not held by this index:
+	for(GuiBaseVecIter it = mHitMoved.begin(); it != mHitMoved.end(); it++) {
+		if( !moveHitEntries( *it ) ) {
+			updateHitIndex();
+			return;
+		}
+	}
+	mHitMoved.clear();
+}
+
+bool GuiBase::moveHitEntries(GuiBase* iNode)
+{
+	// Check that the node is held by this index (a nested index may have reassigned its order):
+	if( iNode->mHitOrder >= mHitEntries.size() || mHitEntries[ iNode->mHitOrder ].mNode != iNode ) { return false; }
+	// An unchanged rect means that the node's descendants have not moved either:
+	HitEntry& tEntry = mHitEntries[ iNode->mHitOrder ];
+	Rectf     tRect  = iNode->getRect();
+	if( tRect.getUpperLeft() == tEntry.mRect.getUpperLeft() && tRect.getLowerRight() == tEntry.mRect.getLowerRight() ) { return true; }
+	// Move the node's entry between cells:
+	updateHitCells( iNode->mHitOrder, false );
+	tEntry.mRect = tRect;
+	updateHitCells( iNode->mHitOrder, true );
+	// Handle children:
+	for(GuiBaseDequeCiter it = iNode->mChildren.begin(); it != iNode->mChildren.end(); it++) {
+		if( !moveHitEntries( *it ) ) { return false; }
+	}
+	return true;
+}
+
+void GuiBase::updateHitCells(const size_t& iEntry, const bool& iInsert)
+{
+	const Rectf& tRect = mHitEntries[ iEntry ].mRect;
+	if( tRect.getWidth() <= 0.0 || tRect.getHeight() <= 0.0 ) { return; }
+	int tCol0 = constrain( (int)floor( tRect.x1 / mHitCellSize ), 0, mHitCols - 1 );
+	int tCol1 = constrain( (int)floor( tRect.x2 / mHitCellSize ), 0, mHitCols - 1 );
+	int tRow0 = constrain( (int)floor( tRect.y1 / mHitCellSize ), 0, mHitRows - 1 );
+	int tRow1 = constrain( (int)floor( tRect.y2 / mHitCellSize ), 0, mHitRows - 1 );
+	for(int r = tRow0; r <= tRow1; r++) {
+		for(int c = tCol0; c <= tCol1; c++) {
+			// Keep each cell sorted in dispatch order:
+			vector<size_t>&          tCell = mHitCells[ r * mHitCols + c ];
+			vector<size_t>::iterator tIter = lower_bound( tCell.begin(), tCell.end(), iEntry );
+			if( iInsert && ( tIter == tCell.end() || *tIter != iEntry ) ) {
+				tCell.insert( tIter, iEntry );
+			}
+			else if( !iInsert && tIter != tCell.end() && *tIter == iEntry ) {
+				tCell.erase( tIter );
+			}
+		}
+	}
+}
+
+void GuiBase::appendHitEntries(std::vector<HitEntry>& oEntries)
+{
+	// Handle children (in reverse, as in the deep event-handlers):
+	for(GuiBaseDequeRiter it = mChildren.rbegin(); it != mChildren.rend(); it++) {
+		(*it)->appendHitEntries( oEntries );
+	}
+	// Handle self:
+	HitEntry tEntry;
+	tEntry.mNode = this;
+	tEntry.mRect = getRect();
+	mHitOrder    = oEntries.size();
+	oEntries.push_back( tEntry );
+}
+
+bool GuiBase::dispatchIndexed(ci::app::MouseEvent iEvent, MouseHandler iHandler, const GuiBaseVec& iExtras, GuiBaseVec* oHits)
+{
+	// Bring index up to date:
+	validateHitIndex();
+	// Gather the nodes under the cursor:
+	GuiBaseVec tNodes;
+	Vec2f tPos = iEvent.getPos();
+	int   tCol = constrain( (int)floor( tPos.x / mHitCellSize ), 0, mHitCols - 1 );
+	int   tRow = constrain( (int)floor( tPos.y / mHitCellSize ), 0, mHitRows - 1 );
+	const vector<size_t>& tCell = mHitCells[ tRow * mHitCols + tCol ];
+	for(vector<size_t>::const_iterator it = tCell.begin(); it != tCell.end(); it++) {
+		if( mHitEntries[ *it ].mRect.contains( tPos ) ) {
+			tNodes.push_back( mHitEntries[ *it ].mNode );
+		}
+	}
+	if( oHits ) {
+		*oHits = tNodes;
+	}
+	// Add extra nodes (such as those the cursor has just left) and restore dispatch order:
+	if( !iExtras.empty() ) {
+		tNodes.insert( tNodes.end(), iExtras.begin(), iExtras.end() );
+		sort( tNodes.begin(), tNodes.end(), [](GuiBase* a, GuiBase* b) { return a->mHitOrder < b->mHitOrder; } );
+		tNodes.erase( unique( tNodes.begin(), tNodes.end() ), tNodes.end() );
+	}
+	// Dispatch to each node whose descendants have not handled the event:
+	bool       tHandled = false;
+	GuiBaseVec tMarked;
+	for(GuiBaseVecCiter it = tNodes.begin(); it != tNodes.end(); it++) {
+		GuiBase* tNode = *it;
+		if( tNode->mHitHandled || !tNode->getVisibility() ) { continue; }
+		if( ( tNode->*iHandler )( iEvent ) ) {
+			tHandled = true;
+			// Mark ancestors up to this node as handled:
+			for(GuiBase* tAnc = tNode->mParent; tAnc != NULL && tAnc != mParent && !tAnc->mHitHandled; tAnc = tAnc->mParent) {
+				tAnc->mHitHandled = true;
+				tMarked.push_back( tAnc );
+			}
+		}
+	}
+	// Clear marks:
+	for(GuiBaseVecIter it = tMarked.begin(); it != tMarked.end(); it++) {
+		(*it)->mHitHandled = false;
+	}
+	return tHandled;
 }
\ No newline at end of file
@@ -21,6 +21,9 @@ GuiPlot::GuiPlot(const string& iFontFamilyName, FontSuitcase* iFontSuitcaseRef)
 	mOriginWeight( 2.0 ),
 	mGridWeight( 1.0 ),
 	mDirty( false ),
+	mOriginCount( 0 ),
+	mGridCount( 0 ),
+	mBatchDirty( true ),
 	mLabelTL( NULL ),
 	mLabelTR( NULL ),
 	mLabelBL( NULL ),
@@ -63,8 +66,6 @@ void GuiPlot::draw()
 {
 	// Update, if dirty:
 	deepRecomputeFormatting();
-	// Get window size:
-	Vec2f tWindowDim = getWindowSize();
 	// Compute draw rect:
 	Vec2f tPos  = getPosition();
 	Vec2f tDim  = getDimension();
@@ -82,8 +83,7 @@ void GuiPlot::draw()
 	gl::lineWidth( toPixels( mStrokeWeight ) );
 	gl::drawStrokedRect( tRect );
 	// Enter scissor region:
-	glEnable( GL_SCISSOR_TEST );
-	glScissor( toPixels( tPos.x ), toPixels( tWindowDim.y - tDim.y - tPos.y ), toPixels( tDim.x ), toPixels( tDim.y ) );
+	beginClip( tRect );
 	// Push graph matrix:
 	gl::pushMatrices();
 	// Translate matrix to rect origin:
@@ -95,37 +95,13 @@ void GuiPlot::draw()
 	// Flip graph (so that top of rect is +Y in graph space):
 	gl::scale( 1.0, -1.0 );
 	gl::translate( 0.0, -mRange.y1 );
-	// Draw origin:
-	gl::color( mOriginColor );
-	gl::lineWidth( toPixels( mOriginWeight ) );
-	gl::drawLine( Vec2f( mRange.x1, 0.0 ), Vec2f( mRange.x2, 0.0 ) );
-	gl::drawLine( Vec2f( 0.0, mRange.y1 ), Vec2f( 0.0, mRange.y2 ) );
-	// Compute appropriate grid increments based on range scale:
-	float tIncrX = min( max( pow( 10.0f, floor( log( tRangeSize.x ) ) - 2.0f ), 0.1f ), 10.0f );
-	float tIncrY = min( max( pow( 10.0f, floor( log( tRangeSize.y ) ) - 2.0f ), 0.1f ), 10.0f );
-	// Draw grid:
-	gl::color( mGridColor );
-	gl::lineWidth( toPixels( mGridWeight ) );
-	float tXs = roundToNearest( mRange.x1, tIncrX );
-	float tXe = mRange.x2 + tIncrX;
-	while( tXs <= tXe ) {
-		gl::drawLine( Vec2f( tXs, mRange.y1 ), Vec2f( tXs, mRange.y2 ) );
-		tXs += tIncrX;
-	}
-	float tYs = roundToNearest( mRange.y1, tIncrY );
-	float tYe = mRange.y2 + tIncrY;
-	while( tYs <= tYe ) {
-		gl::drawLine( Vec2f( mRange.x1, tYs ), Vec2f( mRange.x2, tYs ) );
-		tYs += tIncrY;
-	}
-	// Draw data:
-	for(PlotterDataRefVecIter it = mInputs.begin(); it != mInputs.end(); it++) {
-		(*it)->draw();
-	}
+	// Draw origin, grid and data:
+	updateBatches( tDim );
+	drawBatches();
 	// Pop graph matrix:
 	gl::popMatrices();
 	// Exit scissor region:
-	glDisable( GL_SCISSOR_TEST );
+	endClip();
 	// Exit line smoothing:
 	glDisable( GL_LINE_SMOOTH );
 }
@@ -165,16 +141,19 @@ bool GuiPlot::mouseUp(app::MouseEvent iEvent)
 void GuiPlot::clearInputs()
 {
 	mInputs.clear();
+	mBatchDirty = true;
 }
 
 void GuiPlot::addInput(const ci::PolyLine2f& iLine, const ci::ColorA& iColor)
 {
 	mInputs.push_back( PlotterDataRef( new PolyLineData( iLine, iColor ) ) );
+	mBatchDirty = true;
 }
 
 void GuiPlot::addInput(PlotterDataRef iDataRef)
 {
 	mInputs.push_back( iDataRef );
+	mBatchDirty = true;
 }
 
 void GuiPlot::removeInput(PlotterDataRef iDataRef)
@@ -182,6 +161,7 @@ void GuiPlot::removeInput(PlotterDataRef iDataRef)
 	for(PlotterDataRefVecCiter it = mInputs.begin(); it != mInputs.end(); it++) {
 		if( (*it).get() == iDataRef.get() ) {
 			mInputs.erase( it );
+			mBatchDirty = true;
 			return;
 		}
 	}
@@ -192,6 +172,7 @@ void GuiPlot::setXRange(const float& iMin, const float &iMax)
 	mRange.x1 = iMin;
 	mRange.x2 = iMax;
 	mDirty = true;
+	mBatchDirty = true;
 }
 
 void GuiPlot::setYRange(const float& iMin, const float &iMax)
@@ -199,11 +180,13 @@ void GuiPlot::setYRange(const float& iMin, const float &iMax)
 	mRange.y1 = iMin;
 	mRange.y2 = iMax;
 	mDirty = true;
+	mBatchDirty = true;
 }
 
 void GuiPlot::setOriginColor(const ci::ColorA& iColor)
 {
 	mOriginColor = iColor;
+	mBatchDirty = true;
 }
 
 const ci::ColorA& GuiPlot::getOriginColor() const
@@ -214,6 +197,7 @@ const ci::ColorA& GuiPlot::getOriginColor() const
 void GuiPlot::setOriginWeight(const float& iWeight)
 {
 	mOriginWeight = iWeight;
+	mBatchDirty = true;
 }
 
 const float& GuiPlot::getOriginWeight() const
@@ -224,6 +208,7 @@ const float& GuiPlot::getOriginWeight() const
 void GuiPlot::setGridColor(const ci::ColorA& iColor)
 {
 	mGridColor = iColor;
+	mBatchDirty = true;
 }
 
 const ci::ColorA& GuiPlot::getGridColor() const
@@ -234,6 +219,7 @@ const ci::ColorA& GuiPlot::getGridColor() const
 void GuiPlot::setGridWeight(const float& iWeight)
 {
 	mGridWeight = iWeight;
+	mBatchDirty = true;
 }
 
 const float& GuiPlot::getGridWeight() const
@@ -260,6 +246,145 @@ void GuiPlot::deepRecomputeFormatting()
 	}
 }
 
+void GuiPlot::updateBatches(const ci::Vec2f& iDim)
+{
+	// Inform inputs of the visible range and check for changes (revisions are only comparable if the input count is unchanged):
+	bool  tCounted  = ( mInputBatched.size() == mInputs.size() && mInputRevisions.size() == mInputs.size() );
+	bool  tChanged  = mBatchDirty || iDim != mBatchDim || !tCounted;
+	Vec2f tPixelDim = toPixels( iDim );
+	for(size_t i = 0; i < mInputs.size(); i++) {
+		mInputs[ i ]->setDrawBounds( mRange, tPixelDim );
+		// Inputs that draw themselves do not affect the batch mesh:
+		if( tCounted && mInputBatched[ i ] && mInputs[ i ]->getRevision() != mInputRevisions[ i ] ) {
+			tChanged = true;
+		}
+	}
+	if( tChanged ) {
+		rebuildBatches( iDim );
+	}
+}
+
+void GuiPlot::rebuildBatches(const ci::Vec2f& iDim)
+{
+	mBatchDirty = false;
+	mBatchDim   = iDim;
+	vector<Vec3f>  tPositions;
+	vector<ColorA> tColors;
+	// Add origin lines:
+	tPositions.push_back( Vec3f( mRange.x1, 0.0, 0.0 ) );
+	tPositions.push_back( Vec3f( mRange.x2, 0.0, 0.0 ) );
+	tPositions.push_back( Vec3f( 0.0, mRange.y1, 0.0 ) );
+	tPositions.push_back( Vec3f( 0.0, mRange.y2, 0.0 ) );
+	mOriginCount = tPositions.size();
+	tColors.resize( mOriginCount, mOriginColor );
+	// Compute appropriate grid increments based on range scale:
+	Vec2f tRangeSize = mRange.getSize();
+	float tIncrX = min( max( pow( 10.0f, floor( log( tRangeSize.x ) ) - 2.0f ), 0.1f ), 10.0f );
+	float tIncrY = min( max( pow( 10.0f, floor( log( tRangeSize.y ) ) - 2.0f ), 0.1f ), 10.0f );
+	// Add grid lines:
+	float tXs = roundToNearest( mRange.x1, tIncrX );
+	float tXe = mRange.x2 + tIncrX;
+	while( tXs <= tXe ) {
+		tPositions.push_back( Vec3f( tXs, mRange.y1, 0.0 ) );
+		tPositions.push_back( Vec3f( tXs, mRange.y2, 0.0 ) );
+		tXs += tIncrX;
+	}
+	float tYs = roundToNearest( mRange.y1, tIncrY );
+	float tYe = mRange.y2 + tIncrY;
+	while( tYs <= tYe ) {
+		tPositions.push_back( Vec3f( mRange.x1, tYs, 0.0 ) );
+		tPositions.push_back( Vec3f( mRange.x2, tYs, 0.0 ) );
+		tYs += tIncrY;
+	}
+	mGridCount = tPositions.size() - mOriginCount;
+	tColors.resize( tPositions.size(), mGridColor );
+	// Collect input strips, setting aside inputs that cannot be batched:
+	PlotterStripVec tStrips;
+	mUnbatchedInputs.clear();
+	mInputRevisions.resize( mInputs.size() );
+	mInputBatched.resize( mInputs.size() );
+	for(size_t i = 0; i < mInputs.size(); i++) {
+		mInputBatched[ i ] = mInputs[ i ]->appendStrips( tStrips );
+		if( !mInputBatched[ i ] ) {
+			mUnbatchedInputs.push_back( mInputs[ i ] );
+		}
+		mInputRevisions[ i ] = mInputs[ i ]->getRevision();
+	}
+	// Add input strips, grouping them by stroke style:
+	mStripBatches.clear();
+	for(PlotterStripVec::const_iterator it = tStrips.begin(); it != tStrips.end(); it++) {
+		if( (*it).mVertices.size() < 2 ) { continue; }
+		vector<StripBatch>::iterator tBatch = mStripBatches.begin();
+		while( tBatch != mStripBatches.end() && ( (*tBatch).mStrokeWeight != (*it).mStrokeWeight || (*tBatch).mStipple != (*it).mStipple ) ) {
+			tBatch++;
+		}
+		if( tBatch == mStripBatches.end() ) {
+			StripBatch tNewBatch;
+			tNewBatch.mStrokeWeight = (*it).mStrokeWeight;
+			tNewBatch.mStipple      = (*it).mStipple;
+			mStripBatches.push_back( tNewBatch );
+			tBatch = mStripBatches.end() - 1;
+		}
+		(*tBatch).mFirsts.push_back( tPositions.size() );
+		(*tBatch).mCounts.push_back( (*it).mVertices.size() );
+		for(vector<Vec2f>::const_iterator vt = (*it).mVertices.begin(); vt != (*it).mVertices.end(); vt++) {
+			tPositions.push_back( Vec3f( (*vt).x, (*vt).y, 0.0 ) );
+		}
+		tColors.resize( tPositions.size(), (*it).mColor );
+	}
+	// Reallocate mesh if the vertices outgrow it (rounding up to limit reallocation as the vertex count varies):
+	if( !mBatchMesh || mBatchMesh->getNumVertices() < tPositions.size() ) {
+		size_t tCapacity = 1024;
+		while( tCapacity < tPositions.size() ) { tCapacity *= 2; }
+		gl::VboMesh::Layout tLayout;
+		tLayout.setDynamicPositions();
+		tLayout.setDynamicColorsRGBA();
+		mBatchMesh = gl::VboMesh::create( tCapacity, 0, tLayout, GL_LINES );
+	}
+	// Upload vertices:
+	mBatchMesh->bufferPositions( tPositions );
+	mBatchMesh->bufferColorsRGBA( tColors );
+}
+
+void GuiPlot::drawBatches()
+{
+	if( !mBatchMesh ) { return; }
+	// Bind vertex and color arrays (restoring client state afterwards):
+	glPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	mBatchMesh->bindAllData();
+	// Draw origin:
+	gl::lineWidth( toPixels( mOriginWeight ) );
+	glDrawArrays( GL_LINES, 0, mOriginCount );
+	// Draw grid:
+	gl::lineWidth( toPixels( mGridWeight ) );
+	glDrawArrays( GL_LINES, mOriginCount, mGridCount );
+	gl::VboMesh::unbindBuffers();
+	glPopClientAttrib();
+	// Draw inputs that cannot be batched (such as overlays) beneath the batched strips:
+	for(PlotterDataRefVecIter it = mUnbatchedInputs.begin(); it != mUnbatchedInputs.end(); it++) {
+		(*it)->draw();
+	}
+	if( mStripBatches.empty() ) { return; }
+	// Draw input strips, one call per stroke style:
+	glPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	mBatchMesh->bindAllData();
+	for(vector<StripBatch>::const_iterator it = mStripBatches.begin(); it != mStripBatches.end(); it++) {
+		gl::lineWidth( toPixels( (*it).mStrokeWeight ) );
+		if( (*it).mStipple ) {
+			glPushAttrib( GL_ENABLE_BIT );
+			glLineStipple( toPixels( 10 ), 0xAAAA );
+			glEnable( GL_LINE_STIPPLE );
+		}
+		glMultiDrawArrays( GL_LINE_STRIP, &(*it).mFirsts[ 0 ], &(*it).mCounts[ 0 ], (*it).mFirsts.size() );
+		if( (*it).mStipple ) {
+			glDisable( GL_LINE_STIPPLE );
+			glPopAttrib();
+		}
+	}
+	gl::VboMesh::unbindBuffers();
+	glPopClientAttrib();
+}
+
 string GuiPlot::getVertexLabelString(const float& iX, const float& iY)
 {
 	stringstream ss;
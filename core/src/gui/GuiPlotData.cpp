@@ -14,7 +14,8 @@ using namespace ci::app;
 
 PlotterData::PlotterData(const ci::ColorA& iColor, const float& iStrokeWeight) :
 	mColor( iColor ),
-	mStrokeWeight( iStrokeWeight )
+	mStrokeWeight( iStrokeWeight ),
+	mRevision( 0 )
 {
 }
 
@@ -32,9 +33,26 @@ void PlotterData::draw()
 	// Overload this method.
 }
 
+void PlotterData::setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim)
+{
+	// Overload this method.
+}
+
+bool PlotterData::appendStrips(PlotterStripVec& oStrips)
+{
+	// Overload this method.
+	return false;
+}
+
+const uint32_t& PlotterData::getRevision() const
+{
+	return mRevision;
+}
+
 void PlotterData::setStrokeColor(const ci::ColorA& iColor)
 {
 	mColor = iColor;
+	mRevision++;
 }
 
 const ci::ColorA& PlotterData::getStrokeColor() const
@@ -45,6 +63,7 @@ const ci::ColorA& PlotterData::getStrokeColor() const
 void PlotterData::setStrokeWeight(const float& iWeight)
 {
 	mStrokeWeight = iWeight;
+	mRevision++;
 }
 
 const float& PlotterData::getStrokeWeight() const
@@ -53,13 +72,31 @@ const float& PlotterData::getStrokeWeight() const
 }
 
 PolyLineData::PolyLineData() :
-	PlotterData()
+	PlotterData(),
+	mMonotonic( true ),
+	mDrawBounds( 0.0, 0.0, 0.0, 0.0 ),
+	mDrawPixelDim( 0.0, 0.0 ),
+	mDirty( true )
 {
 }
 
 PolyLineData::PolyLineData(const ci::PolyLine2f& iData, const ci::ColorA& iColor, const float& iStrokeWeight) :
-	PlotterData( iColor, iStrokeWeight ), mData( iData )
+	PlotterData( iColor, iStrokeWeight ), mData( iData ),
+	mMonotonic( !iData.isClosed() ),
+	mDrawBounds( 0.0, 0.0, 0.0, 0.0 ),
+	mDrawPixelDim( 0.0, 0.0 ),
+	mDirty( true )
 {
+	// Build decimation pyramid while the x-values never decrease:
+	const vector<Vec2f>& tPoints = mData.getPoints();
+	for(size_t i = 0; i < tPoints.size() && mMonotonic; i++) {
+		if( i > 0 && tPoints[ i ].x < tPoints[ i - 1 ].x ) {
+			mMonotonic = false;
+			mLevels.clear();
+			break;
+		}
+		updatePyramid( i );
+	}
 }
 
 PolyLineData::~PolyLineData()
@@ -73,10 +110,153 @@ PlotterData* PolyLineData::clone()
 
 void PolyLineData::draw()
 {
+	// Update decimated vertices, if dirty:
+	if( mDirty ) {
+		updateDecimated();
+	}
 	// Set stroke weight:
 	gl::lineWidth( toPixels( mStrokeWeight ) );
 	// Set stroke color:
 	gl::color( mColor );
-	// Draw data:
-	gl::draw( mData );
-}
\ No newline at end of file
+	// Draw data straight from the cached vertices (restoring client state afterwards):
+	if( mDecimated.size() < 2 ) { return; }
+	glPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glVertexPointer( 2, GL_FLOAT, 0, &mDecimated[ 0 ] );
+	glDrawArrays( GL_LINE_STRIP, 0, (GLsizei)mDecimated.size() );
+	glPopClientAttrib();
+}
+
+void PolyLineData::setDrawBounds(const ci::Rectf& iRange, const ci::Vec2f& iPixelDim)
+{
+	if( iRange.getUpperLeft() != mDrawBounds.getUpperLeft() || iRange.getLowerRight() != mDrawBounds.getLowerRight() || iPixelDim != mDrawPixelDim ) {
+		mDrawBounds   = iRange;
+		mDrawPixelDim = iPixelDim;
+		mDirty        = true;
+		mRevision++;
+	}
+}
+
+bool PolyLineData::appendStrips(PlotterStripVec& oStrips)
+{
+	// Update decimated vertices, if dirty:
+	if( mDirty ) {
+		updateDecimated();
+	}
+	oStrips.push_back( PlotterStrip( mColor, mStrokeWeight ) );
+	oStrips.back().mVertices = mDecimated;
+	return true;
+}
+
+void PolyLineData::appendPoint(const ci::Vec2f& iPoint)
+{
+	if( mMonotonic && !mData.getPoints().empty() && iPoint.x < mData.getPoints().back().x ) {
+		mMonotonic = false;
+		mLevels.clear();
+	}
+	mData.push_back( iPoint );
+	updatePyramid( mData.size() - 1 );
+	mDirty = true;
+	mRevision++;
+}
+
+const ci::PolyLine2f& PolyLineData::getData() const
+{
+	return mData;
+}
+
+void PolyLineData::updatePyramid(const size_t& iIndex)
+{
+	// Only the second point of each pair starts a new level 0 bucket:
+	if( !mMonotonic || iIndex % 2 == 0 ) { return; }
+	const vector<Vec2f>& tPoints = mData.getPoints();
+	Bucket tBucket = mergeBuckets( makeBucket( tPoints[ iIndex - 1 ] ), makeBucket( tPoints[ iIndex ] ) );
+	// Push the bucket, merging completed pairs upward (each level receives half as many buckets as the one below):
+	for(size_t tLevel = 0; ; tLevel++) {
+		if( mLevels.size() == tLevel ) {
+			mLevels.push_back( BucketVec() );
+		}
+		BucketVec& tBuckets = mLevels[ tLevel ];
+		tBuckets.push_back( tBucket );
+		if( tBuckets.size() % 2 == 1 ) { break; }
+		tBucket = mergeBuckets( tBuckets[ tBuckets.size() - 2 ], tBuckets.back() );
+	}
+}
+
+void PolyLineData::updateDecimated()
+{
+	mDirty = false;
+	const vector<Vec2f>& tPoints = mData.getPoints();
+	mDecimated.clear();
+	// Draw every point if the pyramid is unusable or unnecessary:
+	if( !mMonotonic || mDrawPixelDim.x <= 0.0 || tPoints.size() <= (size_t)( mDrawPixelDim.x * 2.0 ) ) {
+		mDecimated = tPoints;
+		if( mData.isClosed() && !tPoints.empty() ) {
+			mDecimated.push_back( tPoints.front() );
+		}
+		return;
+	}
+	// Find the visible points, including one neighbor on either side:
+	float  tMinX  = min( mDrawBounds.x1, mDrawBounds.x2 );
+	float  tMaxX  = max( mDrawBounds.x1, mDrawBounds.x2 );
+	size_t tBegin = lower_bound( tPoints.begin(), tPoints.end(), tMinX, [](const Vec2f& iPt, const float& iX) { return iPt.x < iX; } ) - tPoints.begin();
+	size_t tEnd   = upper_bound( tPoints.begin(), tPoints.end(), tMaxX, [](const float& iX, const Vec2f& iPt) { return iX < iPt.x; } ) - tPoints.begin();
+	tBegin = ( tBegin > 0 ) ? ( tBegin - 1 ) : ( 0 );
+	tEnd   = min( tEnd + 1, tPoints.size() );
+	if( tBegin >= tEnd ) { return; }
+	// Draw the visible points directly if there are few enough:
+	float tPointsPerColumn = ( tEnd - tBegin ) / mDrawPixelDim.x;
+	if( tPointsPerColumn < 2.0 ) {
+		mDecimated.assign( tPoints.begin() + tBegin, tPoints.begin() + tEnd );
+		return;
+	}
+	// Choose the coarsest level whose runs span no more than one pixel column:
+	size_t tMaxLevel = 0;
+	while( tMaxLevel + 1 < mLevels.size() && (float)( 4 << tMaxLevel ) <= tPointsPerColumn ) {
+		tMaxLevel++;
+	}
+	// Cover the visible points with the largest aligned runs available, falling back to single points at the edges:
+	size_t i = tBegin;
+	while( i < tEnd ) {
+		int tLevel = (int)min( tMaxLevel, mLevels.size() - 1 );
+		for(; tLevel >= 0; tLevel--) {
+			size_t tRun = (size_t)2 << tLevel;
+			if( i % tRun == 0 && i + tRun <= tEnd && i / tRun < mLevels[ tLevel ].size() ) { break; }
+		}
+		if( tLevel < 0 ) {
+			mDecimated.push_back( tPoints[ i ] );
+			i++;
+			continue;
+		}
+		// Emit the run's extremes in the order in which they occur:
+		const Bucket& tBucket = mLevels[ tLevel ][ i / ( (size_t)2 << tLevel ) ];
+		mDecimated.push_back( Vec2f( tBucket.mXFirst, ( tBucket.mMinFirst ) ? ( tBucket.mYMin ) : ( tBucket.mYMax ) ) );
+		mDecimated.push_back( Vec2f( tBucket.mXLast,  ( tBucket.mMinFirst ) ? ( tBucket.mYMax ) : ( tBucket.mYMin ) ) );
+		i += (size_t)2 << tLevel;
+	}
+}
+
+PolyLineData::Bucket PolyLineData::makeBucket(const ci::Vec2f& iPoint)
+{
+	Bucket tBucket = { iPoint.x, iPoint.x, iPoint.y, iPoint.y, true };
+	return tBucket;
+}
+
+PolyLineData::Bucket PolyLineData::mergeBuckets(const Bucket& iFirst, const Bucket& iSecond)
+{
+	Bucket tBucket;
+	tBucket.mXFirst = iFirst.mXFirst;
+	tBucket.mXLast  = iSecond.mXLast;
+	// Keep the earlier extreme on ties:
+	bool tMinInFirst = iFirst.mYMin <= iSecond.mYMin;
+	bool tMaxInFirst = iFirst.mYMax >= iSecond.mYMax;
+	tBucket.mYMin = ( tMinInFirst ) ? ( iFirst.mYMin ) : ( iSecond.mYMin );
+	tBucket.mYMax = ( tMaxInFirst ) ? ( iFirst.mYMax ) : ( iSecond.mYMax );
+	if( tMinInFirst == tMaxInFirst ) {
+		tBucket.mMinFirst = ( tMinInFirst ) ? ( iFirst.mMinFirst ) : ( iSecond.mMinFirst );
+	}
+	else {
+		tBucket.mMinFirst = tMinInFirst;
+	}
+	return tBucket;
+}
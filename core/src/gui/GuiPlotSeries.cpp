@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////
+/*         Evolution as a Creative Tool         */
+/*           Taught by Patrick Hebron           */
+/* Interactive Telecommunications Program (ITP) */
+/*             New York University              */
+/*                  Fall 2013                   */
+//////////////////////////////////////////////////
+
+#include "GuiPlotSeries.h"
+
+using namespace std;
+using namespace ci;
+using namespace ci::app;
+
+PlotSeries::PlotSeries(const size_t& iCapacity, const size_t& iQueueCapacity, const ci::ColorA& iColor, const float& iStrokeWeight) :
+	PlotterData( iColor, iStrokeWeight ),
+	mPoints( max( iCapacity, (size_t)2 ) + 1 ),
+	mCapacity( max( iCapacity, (size_t)2 ) ),
+	mHead( 0 ),
+	mSize( 0 ),
+	mPending( 0 ),
+	mQueueCapacity( iQueueCapacity ),
+	mQueue( iQueueCapacity )
+{
+}
+
+PlotSeries::~PlotSeries()
+{
+}
+
+PlotterData* PlotSeries::clone()
+{
+	PlotSeries* tClone = new PlotSeries( mCapacity, mQueueCapacity, mColor, mStrokeWeight );
+	for(size_t i = 0; i < mSize; i++) {
+		tClone->append( getPoint( i ) );
+	}
+	return tClone;
+}
+
+void PlotSeries::draw()
+{
+	// Drain pending points and upload new ones:
+	update();
+	upload();
+	if( mSize < 2 ) { return; }
+	// Set stroke weight:
+	gl::lineWidth( toPixels( mStrokeWeight ) );
+	// Set stroke color:
+	gl::color( mColor );
+	// Bind vertex buffer (restoring client state afterwards):
+	glPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	mVbo.bind();
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glVertexPointer( 2, GL_FLOAT, 0, 0 );
+	// Draw data:
+	if( mSize < mCapacity || mHead == 0 ) {
+		glDrawArrays( GL_LINE_STRIP, ( mSize < mCapacity ) ? ( 0 ) : ( mHead ), mSize );
+	}
+	else {
+		// Draw the oldest points through the mirrored slot, then continue from the start of the buffer:
+		glDrawArrays( GL_LINE_STRIP, mHead, mCapacity + 1 - mHead );
+		glDrawArrays( GL_LINE_STRIP, 0, mHead );
+	}
+	mVbo.unbind();
+	glPopClientAttrib();
+}
+
+bool PlotSeries::push(const ci::Vec2f& iPoint)
+{
+	return mQueue.push( iPoint );
+}
+
+void PlotSeries::append(const ci::Vec2f& iPoint)
+{
+	mPoints[ mHead ] = iPoint;
+	// Mirror the first slot:
+	if( mHead == 0 ) {
+		mPoints[ mCapacity ] = iPoint;
+	}
+	mHead    = ( mHead + 1 ) % mCapacity;
+	mSize    = min( mSize + 1, mCapacity );
+	mPending = min( mPending + 1, mCapacity );
+	mRevision++;
+}
+
+size_t PlotSeries::update()
+{
+	size_t tCount = 0;
+	Vec2f  tPoint;
+	while( mQueue.pop( tPoint ) ) {
+		append( tPoint );
+		tCount++;
+	}
+	return tCount;
+}
+
+const size_t& PlotSeries::getSize() const
+{
+	return mSize;
+}
+
+const size_t& PlotSeries::getCapacity() const
+{
+	return mCapacity;
+}
+
+const size_t& PlotSeries::getQueueCapacity() const
+{
+	return mQueueCapacity;
+}
+
+const ci::Vec2f& PlotSeries::getPoint(const size_t& iIndex) const
+{
+	return mPoints[ ( mHead + mCapacity - mSize + iIndex ) % mCapacity ];
+}
+
+void PlotSeries::upload()
+{
+	// Allocate vertex buffer, if necessary:
+	if( !mVbo ) {
+		mVbo = gl::Vbo( GL_ARRAY_BUFFER );
+		mVbo.bufferData( mPoints.size() * sizeof( Vec2f ), NULL, GL_STREAM_DRAW );
+		mPending = mSize;
+	}
+	if( mPending == 0 ) { return; }
+	// Upload only the slots written since the last upload (in two pieces if they wrap around):
+	mVbo.bind();
+	size_t tBegin = ( mHead + mCapacity - mPending ) % mCapacity;
+	if( tBegin < mHead ) {
+		uploadRange( tBegin, mHead );
+	}
+	else {
+		uploadRange( tBegin, mCapacity );
+		uploadRange( 0, mHead );
+	}
+	// Upload the mirrored slot along with the first:
+	if( tBegin == 0 || tBegin >= mHead ) {
+		uploadRange( mCapacity, mCapacity + 1 );
+	}
+	mVbo.unbind();
+	mPending = 0;
+}
+
+void PlotSeries::uploadRange(const size_t& iBegin, const size_t& iEnd)
+{
+	if( iEnd <= iBegin ) { return; }
+	mVbo.bufferSubData( iBegin * sizeof( Vec2f ), ( iEnd - iBegin ) * sizeof( Vec2f ), &mPoints[ iBegin ] );
+}
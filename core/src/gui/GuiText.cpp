@@ -16,7 +16,8 @@ GuiText::GuiText(std::string iText, std::string iFontName, int iFontSize, FontSt
 	mRetina( app::getWindowContentScale() > 1 ),
 	mTextColor( ColorA::white() ),
 	mHighlightColor( ColorA( 0, 0, 0, 0 ) ),
-	mGuides( false )
+	mGuides( false ),
+	mSuitcaseRef( iSuitcaseRef )
 {
 	if( iSuitcaseRef ) {
 		FontFamily* tFamily = iSuitcaseRef->getFamilyRef( iFontName );
@@ -59,21 +60,35 @@ void GuiText::draw()
 		gl::color( 0, 1, 1 );
 		gl::drawLine( tTextDscnt, tTextDscnt + Vec2f( mDimension.x, 0 ) );
 	}
-	// Draw text:
-	gl::color( mTextColor );
-	mFontRef->drawGlyphs( mGlyphs, tPosOffset, mFontOptions );
+	// Draw text (adding it to the suitcase's batch, if active and unclipped):
+	if( mSuitcaseRef && mSuitcaseRef->getBatch().isActive() && !mDrawClipped ) {
+		mSuitcaseRef->getBatch().addGlyphs( mFontRef, mFontOptions, mGlyphs, tPosOffset, mTextColor );
+	}
+	else {
+		gl::color( mTextColor );
+		mFontRef->drawGlyphs( mGlyphs, tPosOffset, mFontOptions );
+	}
 }
 
 void GuiText::setText(const string& iText)
 {
+	// Skip unchanged strings:
+	if( iText == mText ) { return; }
 	// Set string value:
 	mText = iText;
-	// Set glyphs:
-	mGlyphs = mFontRef->getGlyphPlacements( mText, mFontOptions );
-	// Set dimensions from string:
-	mDimension = mFontRef->measureString( mText, mFontOptions ) * ( mRetina ? 0.5 : 1.0 );
+	// Set glyphs and dimensions from string (shaping it, if not cached):
+	if( mSuitcaseRef ) {
+		const GlyphRun& tRun = mSuitcaseRef->getRunCache().getRun( mFontRef, mText, mFontOptions );
+		mGlyphs    = tRun.mGlyphs;
+		mDimension = tRun.mSize * ( mRetina ? 0.5 : 1.0 );
+	}
+	else {
+		mGlyphs    = mFontRef->getGlyphPlacements( mText, mFontOptions );
+		mDimension = mFontRef->measureString( mText, mFontOptions ) * ( mRetina ? 0.5 : 1.0 );
+	}
 	mFlowW = UI_FIXED;
 	mFlowH = UI_FIXED;
+	invalidateLayout();
 }
 
 const string& GuiText::getText() const
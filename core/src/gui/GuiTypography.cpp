@@ -168,6 +168,135 @@ FontFamilyNode* FontFamily::getNodeRef(const int& iSize)
 	return (*iter).second;
 }
 
+#pragma mark -
+#pragma mark GLYPH_RUN_CACHE
+
+GlyphRunCache::GlyphRunCache(const size_t& iCapacity) :
+	mCapacity( iCapacity )
+{
+}
+
+GlyphRunCache::~GlyphRunCache()
+{
+}
+
+const GlyphRun& GlyphRunCache::getRun(const ci::gl::TextureFontRef& iFont, const string& iText, const ci::gl::TextureFont::DrawOptions& iOptions)
+{
+	GlyphRunKey tKey( iFont.get(), iText );
+	// Try to find run in map:
+	GlyphRunMap::iterator iter = mLookup.find( tKey );
+	// If found, move it to the front of the list and return:
+	if( iter != mLookup.end() ) {
+		mRuns.splice( mRuns.begin(), mRuns, (*iter).second );
+		return (*iter).second->second;
+	}
+	// If not found, shape it and insert:
+	mRuns.push_front( GlyphRunItem( tKey, GlyphRun() ) );
+	GlyphRun& tRun = mRuns.front().second;
+	tRun.mGlyphs = iFont->getGlyphPlacements( iText, iOptions );
+	tRun.mSize   = iFont->measureString( iText, iOptions );
+	mLookup[ tKey ] = mRuns.begin();
+	evict();
+	return tRun;
+}
+
+void GlyphRunCache::clear()
+{
+	mRuns.clear();
+	mLookup.clear();
+}
+
+void GlyphRunCache::setCapacity(const size_t& iCapacity)
+{
+	mCapacity = iCapacity;
+	evict();
+}
+
+const size_t& GlyphRunCache::getCapacity() const
+{
+	return mCapacity;
+}
+
+size_t GlyphRunCache::getSize() const
+{
+	return mRuns.size();
+}
+
+void GlyphRunCache::evict()
+{
+	// Keep at least the most recently used run:
+	while( mRuns.size() > max( mCapacity, (size_t)1 ) ) {
+		mLookup.erase( mRuns.back().first );
+		mRuns.pop_back();
+	}
+}
+
+#pragma mark -
+#pragma mark GLYPH_BATCH
+
+GlyphBatch::GlyphBatch() :
+	mActive( false )
+{
+}
+
+GlyphBatch::~GlyphBatch()
+{
+}
+
+void GlyphBatch::begin()
+{
+	mActive = true;
+}
+
+void GlyphBatch::end()
+{
+	mActive = false;
+	flush();
+}
+
+void GlyphBatch::flush()
+{
+	// Draw each font's glyphs with their per-glyph colors:
+	gl::color( ColorA::white() );
+	for(vector<FontBatch>::iterator it = mBatches.begin(); it != mBatches.end(); it++) {
+		if( !(*it).mGlyphs.empty() ) {
+			(*it).mFont->drawGlyphs( (*it).mGlyphs, Vec2f::zero(), (*it).mOptions, (*it).mColors );
+		}
+		// Keep allocations for the next frame:
+		(*it).mGlyphs.clear();
+		(*it).mColors.clear();
+	}
+}
+
+const bool& GlyphBatch::isActive() const
+{
+	return mActive;
+}
+
+void GlyphBatch::addGlyphs(const ci::gl::TextureFontRef& iFont, const ci::gl::TextureFont::DrawOptions& iOptions,
+						   const GlyphVec& iGlyphs, const ci::Vec2f& iBaseline, const ci::ColorA& iColor)
+{
+	// Find or add the font's batch:
+	vector<FontBatch>::iterator tBatch = mBatches.begin();
+	while( tBatch != mBatches.end() && (*tBatch).mFont != iFont ) {
+		tBatch++;
+	}
+	if( tBatch == mBatches.end() ) {
+		mBatches.push_back( FontBatch() );
+		tBatch = mBatches.end() - 1;
+		(*tBatch).mFont    = iFont;
+		(*tBatch).mOptions = iOptions;
+	}
+	// Add glyphs, offset to the baseline (glyph placements are scaled by the draw options when drawn):
+	Vec2f    tOffset = iBaseline / iOptions.getScale();
+	ColorA8u tColor  = ColorA8u( (uint8_t)( constrain( iColor.r, 0.0f, 1.0f ) * 255.0f ), (uint8_t)( constrain( iColor.g, 0.0f, 1.0f ) * 255.0f ),
+								 (uint8_t)( constrain( iColor.b, 0.0f, 1.0f ) * 255.0f ), (uint8_t)( constrain( iColor.a, 0.0f, 1.0f ) * 255.0f ) );
+	for(GlyphVec::const_iterator it = iGlyphs.begin(); it != iGlyphs.end(); it++) {
+		(*tBatch).mGlyphs.push_back( GlyphPair( (*it).first, (*it).second + tOffset ) );
+		(*tBatch).mColors.push_back( tColor );
+	}
+}
+
 #pragma mark -
 #pragma mark FONT_SUITCASE
 
@@ -216,3 +345,14 @@ ci::gl::TextureFontRef FontSuitcase::getFontRef(const string& iFamilyName, const
 	}
 	return NULL;
 }
+
+
+GlyphRunCache& FontSuitcase::getRunCache()
+{
+	return mRunCache;
+}
+
+GlyphBatch& FontSuitcase::getBatch()
+{
+	return mBatch;
+}
\ No newline at end of file